@@ -0,0 +1,63 @@
+#ifndef CPPUTILS_BENCH_SUITE_HPP
+#define CPPUTILS_BENCH_SUITE_HPP
+
+#include "cpputils/misc/benchmark_registry.hpp"
+#include "cpputils/misc/benchmark_runner.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace cpputils::bench {
+
+using duration_t = std::chrono::duration<double, std::nano>;
+using logger_t = benchmark::statistics_logger<duration_t>;
+using registry_t = benchmark::registry<logger_t>;
+
+// Every component is registered twice, as "<component>/cpputils" and "<component>/hand_written"
+inline constexpr auto library_suffix = "/cpputils";
+inline constexpr auto hand_written_suffix = "/hand_written";
+
+struct two_vectors {
+    std::vector<std::int32_t> lhs;
+    std::vector<std::int32_t> rhs;
+};
+
+// Same values on every run, so that results of different runs can be compared
+[[nodiscard]] inline std::vector<std::int32_t> random_values(std::size_t n, std::uint32_t seed = 42) {
+    std::mt19937 engine{seed};
+    std::uniform_int_distribution<std::int32_t> values{-1'000, 1'000};
+    std::vector<std::int32_t> v(n);
+    for (auto &x : v) { x = values(engine); }
+    return v;
+}
+
+[[nodiscard]] inline two_vectors random_pair(std::size_t n) {
+    return {.lhs = random_values(n, 1U), .rhs = random_values(n, 2U)};
+}
+
+struct three_float_vectors {
+    std::vector<float> a;
+    std::vector<float> b;
+    std::vector<float> c;
+};
+
+[[nodiscard]] inline std::vector<float> random_floats(std::size_t n, std::uint32_t seed) {
+    std::mt19937 engine{seed};
+    std::uniform_real_distribution<float> values{-1.0F, 1.0F};
+    std::vector<float> v(n);
+    for (auto &x : v) { x = values(engine); }
+    return v;
+}
+
+[[nodiscard]] inline three_float_vectors random_float_triple(std::size_t n) {
+    return {.a = random_floats(n, 1U), .b = random_floats(n, 2U), .c = random_floats(n, 3U)};
+}
+
+void add_range_benchmarks(registry_t &registry, std::vector<std::size_t> const &sizes);
+void add_type_benchmarks(registry_t &registry, std::vector<std::size_t> const &sizes);
+
+}  // namespace cpputils::bench
+
+#endif
@@ -0,0 +1,117 @@
+#include "bench_suite.hpp"
+#include "cpputils/misc/benchmark.hpp"
+#include "cpputils/misc/benchmark_compare.hpp"
+#include "cpputils/misc/benchmark_registry.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Usage: cpputils_bench [--quick] [--json <results.json>] [--baseline <results.json>] [--threshold <relative>]
+// The results of a run can be stored with --json and used as the baseline of a later run: the exit
+// code is non-zero if a section regressed.
+
+using namespace cpputils::benchmark;
+using namespace cpputils::bench;
+
+namespace {
+struct options {
+    bool quick{false};
+    std::optional<std::string> json{};
+    std::optional<std::string> baseline{};
+    double threshold{0.05};
+};
+
+std::optional<options> parse_options(std::span<char *> args) {
+    options parsed{};
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        std::string_view const arg{args[i]};
+        auto const has_value = i + 1U < args.size();
+        if (arg == "--quick") {
+            parsed.quick = true;
+        } else if (arg == "--json" && has_value) {
+            parsed.json = args[++i];
+        } else if (arg == "--baseline" && has_value) {
+            parsed.baseline = args[++i];
+        } else if (arg == "--threshold" && has_value) {
+            parsed.threshold = std::stod(args[++i]);
+        } else {
+            return std::nullopt;
+        }
+    }
+    return parsed;
+}
+
+// Time of the library component relative to its hand-written equivalent, for every size
+void print_overhead(std::span<complexity_result const> results) {
+    std::cout << "component,size,cpputils,hand_written,ratio,unit_of_measure\n";
+    for (auto const &library : results) {
+        auto const suffix_position = library.name.rfind(library_suffix);
+        if (suffix_position == std::string::npos) { continue; }
+        auto const component = library.name.substr(0, suffix_position);
+        auto const hand_written = std::ranges::find(results, component + hand_written_suffix, &complexity_result::name);
+        if (hand_written == results.end()) { continue; }
+        for (std::size_t i = 0; i < library.points.size() && i < hand_written->points.size(); ++i) {
+            auto const [size, time] = library.points[i];
+            auto const reference = hand_written->points[i].second;
+            std::cout << component << ',' << size << ',' << time << ',' << reference << ',' << time / reference << ',' << library.time_unit << '\n';
+        }
+    }
+}
+
+std::optional<run_results> read_results(std::string const &path) {
+    std::ifstream file{path};
+    if (!file) { return std::nullopt; }
+    std::string const content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    return parse_results(content);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    auto const opts = parse_options(std::span{argv, static_cast<std::size_t>(argc)});
+    if (!opts) {
+        std::cerr << "usage: cpputils_bench [--quick] [--json <results.json>] [--baseline <results.json>] [--threshold <relative>]\n";
+        return EXIT_FAILURE;
+    }
+    auto const sizes = opts->quick ? size_range(64U, 4'096U, 4U) : size_range(64U, 262'144U, 4U);
+    auto const run = opts->quick ? run_options{.warmup_rounds = 2, .samples = 10, .target_time = std::chrono::milliseconds{10}}
+                                 : run_options{};
+
+    registry_t registry{};
+    add_range_benchmarks(registry, sizes);
+    add_type_benchmarks(registry, sizes);
+
+    logger_t logger{};
+    auto const results = registry.run(logger, run);
+
+    std::cout << std::setprecision(4);
+    print_overhead(results);
+    std::cout << '\n';
+    auto sink = ostream_sink{std::cout};
+    write_complexity(results, sink);
+
+    if (opts->json) {
+        std::ofstream file{*opts->json};
+        reporter<formatters::json_results>::write<formatters::json_results>(logger, file);
+    }
+    if (opts->baseline) {
+        auto const baseline = read_results(*opts->baseline);
+        if (!baseline) {
+            std::cerr << "cannot read the baseline " << *opts->baseline << '\n';
+            return EXIT_FAILURE;
+        }
+        auto const comparison = compare(*baseline, collect_results(logger), {.threshold = opts->threshold});
+        std::cout << '\n';
+        write_comparison(comparison, sink);
+        if (comparison.has_regressions()) { return EXIT_FAILURE; }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+#include "bench_suite.hpp"
+#include "cpputils/functional/chunk.hpp"
+#include "cpputils/functional/enumerate.hpp"
+#include "cpputils/functional/operator_sections.hpp"
+#include "cpputils/functional/tovector.hpp"
+#include "cpputils/functional/zip.hpp"
+#include "cpputils/functional/zip_with.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+
+namespace cpputils::bench {
+
+namespace {
+    void add_zip(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        registry.add(std::string{"zip"} + library_suffix, sizes, random_pair, [](two_vectors const &in) {
+            std::int64_t dot{};
+            for (auto const [l, r] : zip(in.lhs, in.rhs)) {
+                dot += static_cast<std::int64_t>(l) * r;
+            }
+            return dot;
+        });
+        registry.add(std::string{"zip"} + hand_written_suffix, sizes, random_pair, [](two_vectors const &in) {
+            std::int64_t dot{};
+            for (std::size_t i = 0; i < in.lhs.size(); ++i) {
+                dot += static_cast<std::int64_t>(in.lhs[i]) * in.rhs[i];
+            }
+            return dot;
+        });
+    }
+
+    // Contiguous inputs are iterated with a single index, like the hand written loop
+    void add_zip_floats(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        registry.add(std::string{"zip_floats"} + library_suffix, sizes, random_float_triple, [](three_float_vectors const &in) {
+            float sum{};
+            for (auto const [a, b, c] : zip(in.a, in.b, in.c)) {
+                sum += a * b + c;
+            }
+            return sum;
+        });
+        registry.add(std::string{"zip_floats"} + hand_written_suffix, sizes, random_float_triple, [](three_float_vectors const &in) {
+            float sum{};
+            for (std::size_t i = 0; i < in.a.size(); ++i) {
+                sum += in.a[i] * in.b[i] + in.c[i];
+            }
+            return sum;
+        });
+    }
+
+    void add_zip_with(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        registry.add(std::string{"zip_with"} + library_suffix, sizes, random_pair, [](two_vectors const &in) {
+            std::int64_t sum{};
+            for (auto const v : zip_with(std::plus<>{}, in.lhs, in.rhs)) {
+                sum += v;
+            }
+            return sum;
+        });
+        registry.add(std::string{"zip_with"} + hand_written_suffix, sizes, random_pair, [](two_vectors const &in) {
+            std::int64_t sum{};
+            for (std::size_t i = 0; i < in.lhs.size(); ++i) {
+                sum += in.lhs[i] + in.rhs[i];
+            }
+            return sum;
+        });
+    }
+
+    // plus is recognised by zip_with, to_vector goes through the vector kernel
+    void add_zip_with_batched(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        registry.add(std::string{"zip_with_batched"} + library_suffix, sizes, random_float_triple, [](three_float_vectors const &in) {
+            return zip_with(plus, in.a, in.b) | to_vector();
+        });
+        registry.add(std::string{"zip_with_batched"} + hand_written_suffix, sizes, random_float_triple, [](three_float_vectors const &in) {
+            std::vector<float> out(in.a.size());
+            for (std::size_t i = 0; i < in.a.size(); ++i) {
+                out[i] = in.a[i] + in.b[i];
+            }
+            return out;
+        });
+    }
+
+    // Eight lanes of partial sums, the inner loop over a chunk of known size is vectorized
+    void add_chunk(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        registry.add(std::string{"chunk"} + library_suffix, sizes, random_float_triple, [](three_float_vectors const &in) {
+            constexpr std::size_t lanes = 8;
+            std::array<float, lanes> partial{};
+            auto chunks = zip(in.a, in.b) | chunk(chunk_size<lanes>);
+            for (auto const [a, b] : chunks) {
+                for (std::size_t i = 0; i < lanes; ++i) {
+                    partial[i] += a[i] * b[i];
+                }
+            }
+            auto const [a_rest, b_rest] = chunks.remainder();
+            for (std::size_t i = 0; i < a_rest.size(); ++i) {
+                partial[i] += a_rest[i] * b_rest[i];
+            }
+            return std::accumulate(partial.begin(), partial.end(), 0.0F);
+        });
+        // Same partial sums, with the blocks indexed by hand
+        registry.add(std::string{"chunk"} + hand_written_suffix, sizes, random_float_triple, [](three_float_vectors const &in) {
+            constexpr std::size_t lanes = 8;
+            std::array<float, lanes> partial{};
+            auto const n = std::min(in.a.size(), in.b.size());
+            auto const full = n - n % lanes;
+            for (std::size_t block = 0; block < full; block += lanes) {
+                for (std::size_t i = 0; i < lanes; ++i) {
+                    partial[i] += in.a[block + i] * in.b[block + i];
+                }
+            }
+            for (std::size_t i = full; i < n; ++i) {
+                partial[i - full] += in.a[i] * in.b[i];
+            }
+            return std::accumulate(partial.begin(), partial.end(), 0.0F);
+        });
+    }
+
+    void add_enumerate(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        auto const make_input = [](std::size_t n) { return random_values(n); };
+        registry.add(std::string{"enumerate"} + library_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            std::int64_t weighted{};
+            for (auto const [i, v] : in | enumerate()) {
+                weighted += static_cast<std::int64_t>(i) * v;
+            }
+            return weighted;
+        });
+        registry.add(std::string{"enumerate"} + hand_written_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            std::int64_t weighted{};
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                weighted += static_cast<std::int64_t>(i) * in[i];
+            }
+            return weighted;
+        });
+    }
+
+    void add_to_vector(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        auto const make_input = [](std::size_t n) { return random_values(n); };
+        auto const twice = [](std::int32_t v) { return v * 2; };
+        registry.add(std::string{"to_vector"} + library_suffix, sizes, make_input, [twice](std::vector<std::int32_t> const &in) {
+            return in | std::views::transform(twice) | to_vector();
+        });
+        registry.add(std::string{"to_vector"} + hand_written_suffix, sizes, make_input, [twice](std::vector<std::int32_t> const &in) {
+            std::vector<std::int32_t> out{};
+            out.reserve(in.size());
+            for (auto const v : in) {
+                out.push_back(twice(v));
+            }
+            return out;
+        });
+    }
+}  // namespace
+
+void add_range_benchmarks(registry_t &registry, std::vector<std::size_t> const &sizes) {
+    add_zip(registry, sizes);
+    add_zip_floats(registry, sizes);
+    add_zip_with(registry, sizes);
+    add_zip_with_batched(registry, sizes);
+    add_chunk(registry, sizes);
+    add_enumerate(registry, sizes);
+    add_to_vector(registry, sizes);
+}
+
+}  // namespace cpputils::bench
@@ -0,0 +1,82 @@
+#include "bench_suite.hpp"
+#include "cpputils/functional/expected.hpp"
+#include "cpputils/functional/operator_sections.hpp"
+#include "cpputils/types/number.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace cpputils::bench {
+
+namespace {
+    // Negative values are errors
+    [[nodiscard]] expected<std::int32_t, char> checked(std::int32_t v) {
+        if (v < 0) { return expected<std::int32_t, char>::err('-'); }
+        return expected<std::int32_t, char>::val(v);
+    }
+
+    [[nodiscard]] bool checked(std::int32_t v, std::int32_t &out) {
+        if (v < 0) { return false; }
+        out = v;
+        return true;
+    }
+
+    void add_expected(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        auto const make_input = [](std::size_t n) { return random_values(n); };
+        registry.add(std::string{"expected"} + library_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            std::int64_t sum{};
+            for (auto const v : in) {
+                sum += checked(v).transform([](std::int32_t x) { return x * 2; }).value_or(0);
+            }
+            return sum;
+        });
+        registry.add(std::string{"expected"} + hand_written_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            std::int64_t sum{};
+            for (auto const v : in) {
+                std::int32_t x{};
+                sum += checked(v, x) ? x * 2 : 0;
+            }
+            return sum;
+        });
+    }
+
+    void add_number(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        auto const make_input = [](std::size_t n) { return random_values(n); };
+        registry.add(std::string{"number"} + library_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            i64 sum{};
+            for (auto const v : in) {
+                sum += i64{v} * i64{3};
+            }
+            return sum.val();
+        });
+        registry.add(std::string{"number"} + hand_written_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            std::int64_t sum{};
+            for (auto const v : in) {
+                sum += std::int64_t{v} * 3;
+            }
+            return sum;
+        });
+    }
+
+    void add_operator_sections(registry_t &registry, std::vector<std::size_t> const &sizes) {
+        auto const make_input = [](std::size_t n) { return random_values(n); };
+        registry.add(std::string{"operator_sections"} + library_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            return std::ranges::count_if(in, _ > 100) + std::ranges::max(in, _ < _);
+        });
+        registry.add(std::string{"operator_sections"} + hand_written_suffix, sizes, make_input, [](std::vector<std::int32_t> const &in) {
+            return std::ranges::count_if(in, [](std::int32_t v) { return v > 100; })
+                   + std::ranges::max(in, [](std::int32_t l, std::int32_t r) { return l < r; });
+        });
+    }
+}  // namespace
+
+void add_type_benchmarks(registry_t &registry, std::vector<std::size_t> const &sizes) {
+    add_expected(registry, sizes);
+    add_number(registry, sizes);
+    add_operator_sections(registry, sizes);
+}
+
+}  // namespace cpputils::bench
@@ -1,6 +1,7 @@
 #ifndef CPPUTILS_INCLUDE_ALL_IN_ONE_HPP
 #define CPPUTILS_INCLUDE_ALL_IN_ONE_HPP
 
+#include "functional/chunk.hpp"
 #include "functional/composition.hpp"
 #include "functional/enumerate.hpp"
 #include "functional/expected.hpp"
@@ -22,6 +23,20 @@
 #include "meta/typelist.hpp"
 
 #include "misc/benchmark.hpp"
+#include "misc/benchmark_alloc.hpp"
+#include "misc/benchmark_cache.hpp"
+#include "misc/benchmark_compare.hpp"
+#include "misc/benchmark_concurrent.hpp"
+#include "misc/benchmark_cpu.hpp"
+#include "misc/benchmark_histogram.hpp"
+#include "misc/benchmark_load.hpp"
+#include "misc/benchmark_perf.hpp"
+#include "misc/benchmark_profile.hpp"
+#include "misc/benchmark_registry.hpp"
+#include "misc/benchmark_runner.hpp"
+#include "misc/benchmark_scaling.hpp"
+#include "misc/benchmark_trace.hpp"
+#include "misc/benchmark_tsc.hpp"
 #include "misc/container_views.hpp"
 #include "misc/system_macros.hpp"
 #include "misc/visitor.hpp"
@@ -0,0 +1,244 @@
+#ifndef CPPUTILS_FUNCTIONAL_CHUNK_HPP
+#define CPPUTILS_FUNCTIONAL_CHUNK_HPP
+
+#include "../internal/adaptors.hpp"
+#include "zip.hpp"
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+// NOLINTNEXTLINE
+#define FWD(x) std::forward<decltype(x)>(x)
+
+namespace cpputils {
+
+// chunk(chunk_size<N>) cuts chunks of N elements, known at compile time
+template <std::size_t N>
+requires(N > 0)
+inline constexpr std::integral_constant<std::size_t, N> chunk_size{};
+
+namespace detail {
+    template <typename>
+    struct is_zip : std::false_type {};
+
+    template <typename... Containers>
+    struct is_zip<zip<Containers...>> : std::true_type {};
+
+    template <typename Range>
+    concept spannable = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>;
+
+    template <typename>
+    struct zip_of_spannables : std::false_type {};
+
+    template <typename... Containers>
+    struct zip_of_spannables<zip<Containers...>> : std::bool_constant<(spannable<Containers> && ...)> {};
+
+    // The contiguous ranges a chunk is cut from: the range itself, or the containers of a zip
+    template <typename Range>
+    struct chunk_sources {
+        using tuple_ptr_type = tuple_ptr<Range>;
+
+        static constexpr tuple_ptr_type data(Range &r) { return tuple_ptr_type{std::ranges::data(r)}; }
+    };
+
+    template <typename... Containers>
+    struct chunk_sources<zip<Containers...>> {
+        using tuple_ptr_type = tuple_ptr<Containers...>;
+
+        static constexpr tuple_ptr_type data(zip<Containers...> &z) {
+            return std::apply([](auto &...containers) { return tuple_ptr_type{std::ranges::data(containers)...}; }, z.bases());
+        }
+    };
+
+    // A span over a range, a tuple of spans over the containers of a zip
+    template <bool Single, std::size_t Extent, typename TuplePtr>
+    struct chunk_of;
+
+    template <std::size_t Extent, typename T>
+    struct chunk_of<true, Extent, std::tuple<T *>> {
+        using type = std::span<T, Extent>;
+    };
+
+    template <std::size_t Extent, typename... Ts>
+    struct chunk_of<false, Extent, std::tuple<Ts *...>> {
+        using type = std::tuple<std::span<Ts, Extent>...>;
+    };
+}  // namespace detail
+
+// Contiguous, sized range cut in chunks of consecutive elements, each one a std::span over the
+// range (a tuple of spans for a zip of contiguous ranges). With a dynamic Extent the last chunk
+// holds the elements left; with a static one every chunk is a std::span<T, Extent> and the
+// elements left are returned by remainder().
+template <std::ranges::view Range, std::size_t Extent = std::dynamic_extent>
+requires std::ranges::sized_range<Range> && (detail::spannable<Range> || detail::zip_of_spannables<Range>::value)
+class chunk_view : public std::ranges::view_interface<chunk_view<Range, Extent>> {
+    using sources = detail::chunk_sources<Range>;
+    using tuple_ptr_type = typename sources::tuple_ptr_type;
+
+    static constexpr bool single = !detail::is_zip<Range>::value;
+    static constexpr bool fixed = Extent != std::dynamic_extent;
+
+    template <std::size_t E>
+    using chunk_type = typename detail::chunk_of<single, E, tuple_ptr_type>::type;
+
+    template <std::size_t E>
+    static constexpr chunk_type<E> make_chunk(tuple_ptr_type const &ptrs, std::size_t offset, std::size_t count) {
+        return std::apply([offset, count](auto *...ptrs_) {
+            return chunk_type<E>{std::span<std::remove_pointer_t<decltype(ptrs_)>, E>{ptrs_ + offset, count}...};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        },
+                          ptrs);
+    }
+
+public:
+    constexpr chunk_view() = default;
+
+    constexpr explicit chunk_view(Range rng) requires fixed
+        : m_range{std::move(rng)}
+        , m_chunk{Extent} {}
+
+    constexpr chunk_view(Range rng, std::size_t chunk) requires(!fixed)
+        : m_range{std::move(rng)}
+        , m_chunk{chunk} {
+        assert(chunk > 0);
+    }
+
+    class iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = chunk_type<Extent>;
+        using reference = value_type;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(tuple_ptr_type ptrs, std::size_t size, std::size_t chunk, difference_type index)
+            : m_ptrs{ptrs}
+            , m_size{size}
+            , m_chunk{chunk}
+            , m_index{index} {}
+
+        [[nodiscard]] constexpr value_type operator*() const {
+            if constexpr (fixed) {
+                return make_chunk<Extent>(m_ptrs, static_cast<std::size_t>(m_index) * Extent, Extent);
+            } else {
+                auto const offset = static_cast<std::size_t>(m_index) * m_chunk;
+                return make_chunk<Extent>(m_ptrs, offset, std::min(m_chunk, m_size - offset));
+            }
+        }
+
+        constexpr auto operator->() = delete;
+
+        [[nodiscard]] constexpr value_type operator[](difference_type n) const { return *(*this + n); }
+
+        constexpr iterator &operator++() {
+            ++m_index;
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr iterator &operator--() {
+            --m_index;
+            return *this;
+        }
+
+        constexpr iterator operator--(int) {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        constexpr iterator &operator+=(difference_type n) {
+            m_index += n;
+            return *this;
+        }
+
+        constexpr iterator &operator-=(difference_type n) {
+            m_index -= n;
+            return *this;
+        }
+
+        [[nodiscard]] friend constexpr iterator operator+(iterator it, difference_type n) { return it += n; }
+        [[nodiscard]] friend constexpr iterator operator+(difference_type n, iterator it) { return it += n; }
+        [[nodiscard]] friend constexpr iterator operator-(iterator it, difference_type n) { return it -= n; }
+
+        [[nodiscard]] friend constexpr difference_type operator-(iterator const &lhs, iterator const &rhs) {
+            return lhs.m_index - rhs.m_index;
+        }
+
+        [[nodiscard]] constexpr bool operator==(iterator const &it) const { return m_index == it.m_index; }
+        [[nodiscard]] constexpr auto operator<=>(iterator const &it) const { return m_index <=> it.m_index; }
+
+    private:
+        tuple_ptr_type m_ptrs{};
+        std::size_t m_size{};
+        std::size_t m_chunk{};
+        difference_type m_index{};
+    };
+
+    constexpr iterator begin() {
+        return iterator{sources::data(m_range), length(), m_chunk, 0};
+    }
+
+    constexpr iterator end() {
+        return iterator{sources::data(m_range), length(), m_chunk, static_cast<std::ptrdiff_t>(size())};
+    }
+
+    // Chunks with a dynamic extent include a last, shorter one
+    [[nodiscard]] constexpr std::size_t size() {
+        if constexpr (fixed) {
+            return length() / Extent;
+        } else {
+            return (length() + m_chunk - 1) / m_chunk;
+        }
+    }
+
+    // The elements after the last full chunk
+    [[nodiscard]] constexpr chunk_type<std::dynamic_extent> remainder() requires fixed {
+        auto const full = size() * Extent;
+        return make_chunk<std::dynamic_extent>(sources::data(m_range), full, length() - full);
+    }
+
+    [[nodiscard]] constexpr std::size_t chunk() const noexcept { return m_chunk; }
+
+private:
+    Range m_range{};
+    std::size_t m_chunk{};
+
+    constexpr std::size_t length() { return static_cast<std::size_t>(std::ranges::size(m_range)); }
+};
+
+// clang-format off
+inline constexpr auto chunk = detail::adaptors::range_adaptor{
+    []<typename Size>(std::ranges::viewable_range auto &&r, Size n) requires std::integral<Size> || std::same_as<Size, std::integral_constant<std::size_t, Size::value>> {
+        using range_type = std::ranges::views::all_t<decltype(r)>;
+        if constexpr (std::integral<Size>) {
+            return chunk_view<range_type>{std::views::all(FWD(r)), static_cast<std::size_t>(n)};
+        } else {
+            return chunk_view<range_type, Size::value>{std::views::all(FWD(r))};
+        }
+    }
+};
+// clang-format on
+
+}  // namespace cpputils
+
+template <typename Range, std::size_t Extent>
+inline constexpr bool std::ranges::enable_borrowed_range<::cpputils::chunk_view<Range, Extent>> = std::ranges::enable_borrowed_range<Range>;
+
+#undef FWD
+
+#endif
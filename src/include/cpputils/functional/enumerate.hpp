@@ -45,30 +45,64 @@ public:
     constexpr explicit enumerate_view(Range rng)
         : enumerate_view{rng, std::size_t{0U}} {}
 
+    // Random access needs to offset the index: only integral indices can
+    static constexpr bool advanceable_index = std::integral<Index>;
+    static constexpr bool bidirectional = std::ranges::bidirectional_range<Range> && requires(Index i) { --i; };
+    static constexpr bool random_access = std::ranges::random_access_range<Range> && advanceable_index;
+
     class iterator {
         using iter_type = std::ranges::iterator_t<Range>;
 
+        static consteval auto concept_tag() {
+            if constexpr (random_access) {
+                return std::random_access_iterator_tag{};
+            } else if constexpr (bidirectional) {
+                return std::bidirectional_iterator_tag{};
+            } else if constexpr (std::ranges::forward_range<Range>) {
+                return std::forward_iterator_tag{};
+            } else {
+                return std::input_iterator_tag{};
+            }
+        }
+
     public:
-        struct sentinel {
-            [[nodiscard]] constexpr bool operator==(sentinel const &) const { return true; }
+        using iterator_concept = decltype(concept_tag());
+        using difference_type = std::ranges::range_difference_t<Range>;
+        using value_type = enumeration;
+        // using pointer = void;
+        using reference = value_type;
+
+        // Holds the end of the range, computed once by enumerate_view::end
+        class sentinel {
+            using sentinel_type = std::ranges::sentinel_t<Range>;
+
+        public:
+            constexpr sentinel() = default;
+
+            constexpr explicit sentinel(sentinel_type last)
+                : m_last{std::move(last)} {}
 
             [[nodiscard]] constexpr bool operator==(iterator const &it) const {
-                return it.m_iter == it.m_last;
+                return it.m_iter == m_last;
+            }
+
+            [[nodiscard]] friend constexpr difference_type operator-(sentinel const &s, iterator const &it) requires std::sized_sentinel_for<sentinel_type, iter_type> {
+                return s.m_last - it.m_iter;
+            }
+
+            [[nodiscard]] friend constexpr difference_type operator-(iterator const &it, sentinel const &s) requires std::sized_sentinel_for<sentinel_type, iter_type> {
+                return it.m_iter - s.m_last;
             }
+
+        private:
+            sentinel_type m_last{};
         };
-        // using iterator_category = std::input_iterator_tag;
-        using iterator_concept = std::input_iterator_tag;
-        using difference_type = std::ptrdiff_t;
-        using value_type = enumeration;
-        // using pointer = void;
-        using reference = value_type;
 
         constexpr iterator() = default;
 
-        constexpr explicit iterator(Range rng, Index index)
-            : m_iter{std::ranges::begin(rng)}
-            , m_last{std::ranges::end(rng)}
-            , m_index{index} {}
+        constexpr explicit iterator(iter_type it, Index index)
+            : m_iter{std::move(it)}
+            , m_index{std::move(index)} {}
 
         constexpr auto operator*() const {
             return value_type{m_index, *m_iter};
@@ -76,28 +110,107 @@ public:
 
         constexpr auto operator->() = delete;
 
-        constexpr auto &operator++() {
-            std::ranges::advance(m_iter, 1);
+        constexpr iterator &operator++() {
+            ++m_iter;
             ++m_index;
             return *this;
         }
 
-        constexpr void operator++(int) {
-            ++*this;
+        constexpr auto operator++(int) {
+            if constexpr (std::ranges::forward_range<Range>) {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            } else {
+                ++*this;
+            }
+        }
+
+        constexpr iterator &operator--() requires bidirectional {
+            --m_iter;
+            --m_index;
+            return *this;
+        }
+
+        constexpr iterator operator--(int) requires bidirectional {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        constexpr iterator &operator+=(difference_type n) requires random_access {
+            m_iter += n;
+            m_index = offset(m_index, n);
+            return *this;
+        }
+
+        constexpr iterator &operator-=(difference_type n) requires random_access {
+            return *this += -n;
+        }
+
+        [[nodiscard]] constexpr auto operator[](difference_type n) const requires random_access {
+            return value_type{offset(m_index, n), m_iter[n]};
+        }
+
+        [[nodiscard]] friend constexpr iterator operator+(iterator it, difference_type n) requires random_access {
+            return it += n;
+        }
+
+        [[nodiscard]] friend constexpr iterator operator+(difference_type n, iterator it) requires random_access {
+            return it += n;
+        }
+
+        [[nodiscard]] friend constexpr iterator operator-(iterator it, difference_type n) requires random_access {
+            return it -= n;
         }
 
-        [[nodiscard]] constexpr bool operator==(iterator const &it) const {
+        [[nodiscard]] friend constexpr difference_type operator-(iterator const &lhs, iterator const &rhs) requires random_access {
+            return lhs.m_iter - rhs.m_iter;
+        }
+
+        [[nodiscard]] constexpr bool operator==(iterator const &it) const requires std::equality_comparable<iter_type> {
             return m_iter == it.m_iter;
         }
 
+        [[nodiscard]] friend constexpr bool operator<(iterator const &lhs, iterator const &rhs) requires random_access {
+            return lhs.m_iter < rhs.m_iter;
+        }
+
+        [[nodiscard]] friend constexpr bool operator>(iterator const &lhs, iterator const &rhs) requires random_access {
+            return rhs < lhs;
+        }
+
+        [[nodiscard]] friend constexpr bool operator<=(iterator const &lhs, iterator const &rhs) requires random_access {
+            return !(rhs < lhs);
+        }
+
+        [[nodiscard]] friend constexpr bool operator>=(iterator const &lhs, iterator const &rhs) requires random_access {
+            return !(lhs < rhs);
+        }
+
     private:
         iter_type m_iter{};
-        iter_type m_last{};
         Index m_index{};
+
+        static constexpr Index offset(Index const &index, difference_type n) requires advanceable_index {
+            return static_cast<Index>(index + static_cast<Index>(n));
+        }
     };
 
-    constexpr auto begin() { return iterator{m_range, m_start}; }
-    constexpr auto end() { return typename iterator::sentinel{}; }
+    constexpr auto begin() { return iterator{std::ranges::begin(m_range), m_start}; }
+
+    // A random access, sized range with an integral index is enumerated as a common range
+    constexpr auto end() {
+        if constexpr (random_access && std::ranges::sized_range<Range>) {
+            return begin() + static_cast<typename iterator::difference_type>(std::ranges::size(m_range));
+        } else {
+            return typename iterator::sentinel{std::ranges::end(m_range)};
+        }
+    }
+
+    [[nodiscard]] constexpr auto size() requires std::ranges::sized_range<Range> {
+        return std::ranges::size(m_range);
+    }
 
 private:
     Range m_range;
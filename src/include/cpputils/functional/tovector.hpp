@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <concepts>
 #include <ranges>
+#include <span>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -17,12 +19,18 @@ namespace cpputils {
 inline constexpr auto to_vector = detail::adaptors::range_adaptor{
     [](std::ranges::input_range auto &&r) /* clang-format off */ requires std::indirectly_copyable<std::ranges::iterator_t<decltype(r)>, std::ranges::iterator_t<std::vector<std::ranges::range_value_t<decltype(r)>>>> /* clang-format off */ {
         std::vector<std::ranges::range_value_t<decltype(r)>> v;
-        if constexpr (requires { std::ranges::size(r); }) {
-            v.reserve(std::ranges::size(r));
+        // Views that compute all their values at once (see zip_with::batched) write them in place
+        if constexpr (requires { std::ranges::size(r); r.materialize_into(std::span{v}); requires std::remove_cvref_t<decltype(r)>::batched; }) {
+            v.resize(std::ranges::size(r));
+            r.materialize_into(std::span{v});
+        } else {
+            if constexpr (requires { std::ranges::size(r); }) {
+                v.reserve(std::ranges::size(r));
+            }
+
+            std::ranges::copy(FWD(r), std::back_inserter(v));
         }
-        
-        std::ranges::copy(FWD(r), std::back_inserter(v));
-        
+
         return v;
     }};
 
@@ -1,14 +1,16 @@
 #ifndef CPPUTILS_FUNCTIONAL_ZIP_HPP
 #define CPPUTILS_FUNCTIONAL_ZIP_HPP
 
+#include <algorithm>
+#include <iterator>
 #include <ranges>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
+#include "../internal/common_tuple.hpp"
 #include "../internal/iter_utils.hpp"
 
-// TODO: iterator could use an index to keep track?
-
 namespace cpputils {
 // clang-format off
 template <std::ranges::view... Containers>
@@ -18,65 +20,258 @@ class zip : public std::ranges::view_interface<zip<Containers...>> {
     // clang-format on
     using tuple_type = std::tuple<Containers...>;
 
+    static constexpr bool all_forward = (std::ranges::forward_range<Containers> && ...);
+    static constexpr bool all_bidirectional = (std::ranges::bidirectional_range<Containers> && ...);
+    static constexpr bool all_random_access = (std::ranges::random_access_range<Containers> && ...);
+    static constexpr bool all_sized = (std::ranges::sized_range<Containers> && ...);
+    // Contiguous, sized containers are iterated with a single index over their data
+    static constexpr bool indexed = ((std::ranges::contiguous_range<Containers> && std::ranges::sized_range<Containers>) && ...);
+
 public:
     constexpr zip() = default;
     explicit constexpr zip(Containers... containers)
         : m_data{containers...} {}
 
 
+    // Holds only the iterators of the containers, or base pointers and a shared index when they are
+    // all contiguous and sized. The iterators always move together, so the first one (or the index)
+    // stands for all of them in comparisons and distances.
     class iterator {
         using tuple_it_type = detail::tuple_iter<Containers...>;
+        using tuple_ptr_type = detail::tuple_ptr<Containers...>;
 
     public:
-        struct sentinel {
-            [[nodiscard]] constexpr bool operator==(sentinel const &) const { return true; }
+        using iterator_concept = detail::common_iterator_concept_t<Containers...>;
+        using difference_type = std::common_type_t<std::ranges::range_difference_t<Containers>...>;
+        using value_type = std::tuple<std::ranges::range_value_t<Containers>...>;
+        using reference = detail::common_tuple<std::ranges::range_reference_t<Containers>...>;
+
+        // The ends are computed once, by zip::end
+        class sentinel {
+            using tuple_end_type = std::tuple<std::ranges::sentinel_t<Containers>...>;
+
+        public:
+            constexpr sentinel() = default;
+
+            explicit constexpr sentinel(tuple_end_type ends)
+                : m_ends{std::move(ends)} {}
 
             [[nodiscard]] constexpr bool operator==(iterator const &it) const {
-                return detail::check_end(it.m_tup, it.m_it_tup);
+                return reached(it, detail::iseq<Containers...>());
+            }
+
+            // clang-format off
+            [[nodiscard]] friend constexpr auto operator-(sentinel const &s, iterator const &it)
+            requires(std::sized_sentinel_for<std::ranges::sentinel_t<Containers>, std::ranges::iterator_t<Containers>> && ...)
+            {
+                return s.distance(it, detail::iseq<Containers...>());
+            }
+
+            [[nodiscard]] friend constexpr auto operator-(iterator const &it, sentinel const &s)
+            requires(std::sized_sentinel_for<std::ranges::sentinel_t<Containers>, std::ranges::iterator_t<Containers>> && ...)
+            {
+                return -(s - it);
+            }
+            // clang-format on
+
+        private:
+            tuple_end_type m_ends{};
+
+            template <std::size_t... I>
+            constexpr bool reached(iterator const &it, std::index_sequence<I...>) const {
+                return (... || (std::get<I>(it.m_it_tup) == std::get<I>(m_ends)));
+            }
+
+            template <std::size_t... I>
+            constexpr difference_type distance(iterator const &it, std::index_sequence<I...>) const {
+                return std::min({static_cast<difference_type>(std::get<I>(m_ends) - std::get<I>(it.m_it_tup))...});
             }
         };
-        // using iterator_category = std::input_iterator_tag;
-        using iterator_concept = std::input_iterator_tag;
-        using difference_type = std::ptrdiff_t;
-        using value_type = detail::tuple_ref<Containers...>;
-        using reference = value_type;
-        // using pointer = void;
 
         constexpr iterator() = default;
 
-        explicit constexpr iterator(tuple_type const &ref)
-            : m_tup{ref}
-            , m_it_tup{detail::make_iter_tuple(ref, detail::iseq<Containers...>())} {}
+        explicit constexpr iterator(tuple_it_type it_tup) requires(!indexed)
+            : m_it_tup{std::move(it_tup)} {}
 
-        constexpr auto operator*() const { return deref(detail::iseq<Containers...>()); }
+        constexpr iterator(tuple_ptr_type ptr_tup, difference_type index) requires indexed
+            : m_ptr_tup{ptr_tup}
+            , m_index{index} {}
+
+        constexpr reference operator*() const { return deref(detail::iseq<Containers...>()); }
 
         constexpr auto operator->() = delete;
 
-        constexpr auto &operator++() {
-            m_it_tup = detail::advance_iter_tuple(m_it_tup, detail::iseq<Containers...>());
+        constexpr iterator &operator++() {
+            if constexpr (indexed) {
+                ++m_index;
+            } else {
+                std::apply([](auto &...its) { (++its, ...); }, m_it_tup);
+            }
             return *this;
         }
 
-        constexpr void operator++(int) {
-            ++*this;
+        constexpr auto operator++(int) {
+            if constexpr (all_forward) {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            } else {
+                ++*this;
+            }
+        }
+
+        constexpr iterator &operator--() requires all_bidirectional {
+            if constexpr (indexed) {
+                --m_index;
+            } else {
+                std::apply([](auto &...its) { (--its, ...); }, m_it_tup);
+            }
+            return *this;
+        }
+
+        constexpr iterator operator--(int) requires all_bidirectional {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        constexpr iterator &operator+=(difference_type n) requires all_random_access {
+            if constexpr (indexed) {
+                m_index += n;
+            } else {
+                std::apply([n](auto &...its) { ((its += static_cast<std::iter_difference_t<std::remove_cvref_t<decltype(its)>>>(n)), ...); }, m_it_tup);
+            }
+            return *this;
+        }
+
+        constexpr iterator &operator-=(difference_type n) requires all_random_access {
+            return *this += -n;
+        }
+
+        [[nodiscard]] constexpr reference operator[](difference_type n) const requires all_random_access {
+            return *(*this + n);
+        }
+
+        [[nodiscard]] friend constexpr iterator operator+(iterator it, difference_type n) requires all_random_access {
+            return it += n;
+        }
+
+        [[nodiscard]] friend constexpr iterator operator+(difference_type n, iterator it) requires all_random_access {
+            return it += n;
         }
 
-        [[nodiscard]] constexpr bool operator==(iterator const &it) const {
-            return m_it_tup == it.m_it_tup;
+        [[nodiscard]] friend constexpr iterator operator-(iterator it, difference_type n) requires all_random_access {
+            return it -= n;
         }
 
+        [[nodiscard]] friend constexpr difference_type operator-(iterator const &lhs, iterator const &rhs) requires all_random_access {
+            return static_cast<difference_type>(lhs.position() - rhs.position());
+        }
+
+        [[nodiscard]] constexpr bool operator==(iterator const &it) const requires all_forward {
+            return position() == it.position();
+        }
+
+        [[nodiscard]] friend constexpr bool operator<(iterator const &lhs, iterator const &rhs) requires all_random_access {
+            return lhs.position() < rhs.position();
+        }
+
+        [[nodiscard]] friend constexpr bool operator>(iterator const &lhs, iterator const &rhs) requires all_random_access {
+            return rhs < lhs;
+        }
+
+        [[nodiscard]] friend constexpr bool operator<=(iterator const &lhs, iterator const &rhs) requires all_random_access {
+            return !(rhs < lhs);
+        }
+
+        [[nodiscard]] friend constexpr bool operator>=(iterator const &lhs, iterator const &rhs) requires all_random_access {
+            return !(lhs < rhs);
+        }
+
+        [[nodiscard]] friend constexpr auto iter_move(iterator const &it) {
+            return it.move_each(detail::iseq<Containers...>());
+        }
+
+        // clang-format off
+        friend constexpr void iter_swap(iterator const &lhs, iterator const &rhs)
+        requires(std::indirectly_swappable<std::ranges::iterator_t<Containers>> && ...)
+        {
+            swap_each(lhs, rhs, detail::iseq<Containers...>());
+        }
+        // clang-format on
+
     private:
-        tuple_type m_tup{};
-        tuple_it_type m_it_tup{};
+        [[no_unique_address]] std::conditional_t<indexed, detail::empty_t<0>, tuple_it_type> m_it_tup{};
+        [[no_unique_address]] std::conditional_t<indexed, tuple_ptr_type, detail::empty_t<1>> m_ptr_tup{};
+        [[no_unique_address]] std::conditional_t<indexed, difference_type, detail::empty_t<2>> m_index{};
+
+        // The iterator of the Ith container
+        template <std::size_t I>
+        constexpr decltype(auto) component() const {
+            if constexpr (indexed) {
+                return std::get<I>(m_ptr_tup) + m_index;
+            } else {
+                return std::get<I>(m_it_tup);
+            }
+        }
+
+        constexpr decltype(auto) position() const {
+            if constexpr (indexed) {
+                return m_index;
+            } else {
+                return std::get<0>(m_it_tup);
+            }
+        }
+
+        template <std::size_t... I>
+        constexpr reference deref(std::index_sequence<I...>) const {
+            if constexpr (indexed) {
+                return reference{std::in_place, std::get<I>(m_ptr_tup)[m_index]...};
+            } else {
+                return reference{std::in_place, *std::get<I>(m_it_tup)...};
+            }
+        }
 
         template <std::size_t... I>
-        constexpr auto deref(std::index_sequence<I...>) const {
-            return value_type{*std::get<I>(m_it_tup)...};
+        constexpr auto move_each(std::index_sequence<I...>) const {
+            return detail::common_tuple<std::ranges::range_rvalue_reference_t<Containers>...>{std::in_place, std::ranges::iter_move(component<I>())...};
+        }
+
+        template <std::size_t... I>
+        static constexpr void swap_each(iterator const &lhs, iterator const &rhs, std::index_sequence<I...>) {
+            (std::ranges::iter_swap(lhs.template component<I>(), rhs.template component<I>()), ...);
         }
     };
 
-    constexpr auto begin() { return iterator{m_data}; }
-    constexpr auto end() { return typename iterator::sentinel{}; }
+    constexpr iterator begin() {
+        if constexpr (indexed) {
+            return iterator{std::apply([](auto &...containers) { return detail::tuple_ptr<Containers...>{std::ranges::data(containers)...}; }, m_data), 0};
+        } else {
+            return iterator{std::apply([](auto &...containers) { return detail::tuple_iter<Containers...>{std::ranges::begin(containers)...}; }, m_data)};
+        }
+    }
+
+    // A random access zip of sized containers is a common range, its end is an iterator
+    constexpr auto end() {
+        if constexpr (all_random_access && all_sized) {
+            return begin() + static_cast<typename iterator::difference_type>(size());
+        } else {
+            return typename iterator::sentinel{std::apply([](auto &...containers) { return std::tuple<std::ranges::sentinel_t<Containers>...>{std::ranges::end(containers)...}; }, m_data)};
+        }
+    }
+
+    // The zipped views
+    [[nodiscard]] constexpr tuple_type &bases() noexcept { return m_data; }
+    [[nodiscard]] constexpr tuple_type const &bases() const noexcept { return m_data; }
+
+    // Size of the shortest container
+    [[nodiscard]] constexpr auto size() requires all_sized {
+        return std::apply([](auto &...containers) {
+            using size_type = std::make_unsigned_t<std::common_type_t<std::ranges::range_size_t<Containers>...>>;
+            return std::min({static_cast<size_type>(std::ranges::size(containers))...});
+        },
+                          m_data);
+    }
 
 private:
     tuple_type m_data;
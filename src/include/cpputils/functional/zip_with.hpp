@@ -1,16 +1,78 @@
 #ifndef CPPUTILS_FUNCTIONAL_ZIP_WITH_HPP
 #define CPPUTILS_FUNCTIONAL_ZIP_WITH_HPP
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
 #include "../internal/iter_utils.hpp"
+#include "../internal/simd.hpp"
+#include "operator_sections.hpp"
 
 namespace cpputils {
+namespace detail {
+    // The element-wise operation of the operator_sections callables (also returned by _ * _ and
+    // the like) and of the transparent std function objects
+    template <typename Func>
+    struct section_op {};
+
+    template <simd::arithmetic_op Op>
+    using section_op_constant = std::integral_constant<simd::arithmetic_op, Op>;
+
+    template <>
+    struct section_op<std::remove_cvref_t<decltype(plus)>> : section_op_constant<simd::arithmetic_op::plus> {};
+    template <>
+    struct section_op<std::remove_cvref_t<decltype(minus)>> : section_op_constant<simd::arithmetic_op::minus> {};
+    template <>
+    struct section_op<std::remove_cvref_t<decltype(multiplies)>> : section_op_constant<simd::arithmetic_op::multiplies> {};
+    template <>
+    struct section_op<std::remove_cvref_t<decltype(divides)>> : section_op_constant<simd::arithmetic_op::divides> {};
+    template <>
+    struct section_op<std::remove_cvref_t<decltype(bit_and)>> : section_op_constant<simd::arithmetic_op::bit_and> {};
+    template <>
+    struct section_op<std::remove_cvref_t<decltype(bit_or)>> : section_op_constant<simd::arithmetic_op::bit_or> {};
+    template <>
+    struct section_op<std::remove_cvref_t<decltype(bit_xor)>> : section_op_constant<simd::arithmetic_op::bit_xor> {};
+    template <>
+    struct section_op<std::plus<>> : section_op_constant<simd::arithmetic_op::plus> {};
+    template <>
+    struct section_op<std::minus<>> : section_op_constant<simd::arithmetic_op::minus> {};
+    template <>
+    struct section_op<std::multiplies<>> : section_op_constant<simd::arithmetic_op::multiplies> {};
+    template <>
+    struct section_op<std::divides<>> : section_op_constant<simd::arithmetic_op::divides> {};
+    template <>
+    struct section_op<std::bit_and<>> : section_op_constant<simd::arithmetic_op::bit_and> {};
+    template <>
+    struct section_op<std::bit_or<>> : section_op_constant<simd::arithmetic_op::bit_or> {};
+    template <>
+    struct section_op<std::bit_xor<>> : section_op_constant<simd::arithmetic_op::bit_xor> {};
+
+    // Two contiguous ranges of the same arithmetic type, combined by a known operation into that type
+    // clang-format off
+    template <typename Func, typename Lhs, typename Rhs>
+    concept batched_operands = std::ranges::contiguous_range<Lhs> && std::ranges::sized_range<Lhs> &&
+                               std::ranges::contiguous_range<Rhs> && std::ranges::sized_range<Rhs> &&
+                               std::same_as<std::ranges::range_value_t<Lhs>, std::ranges::range_value_t<Rhs>> &&
+                               requires { section_op<Func>::value; } &&
+                               simd::vectorizable<section_op<Func>::value, std::ranges::range_value_t<Lhs>> &&
+                               std::same_as<std::invoke_result_t<Func, std::ranges::range_reference_t<Lhs>, std::ranges::range_reference_t<Rhs>>,
+                                            std::ranges::range_value_t<Lhs>>;
+    // clang-format on
+
+    template <typename Func, typename... Containers>
+    inline constexpr bool batched_v = false;
+
+    template <typename Func, typename Lhs, typename Rhs>
+    requires batched_operands<Func, Lhs, Rhs>
+    inline constexpr bool batched_v<Func, Lhs, Rhs> = true;
+}  // namespace detail
+
 // clang-format off
 template <typename Func, std::ranges::view... Containers>
 requires (std::ranges::input_range<Containers> &&...) &&
@@ -20,7 +82,14 @@ class zip_with : public std::ranges::view_interface<zip_with<Func, Containers...
     // clang-format on
     using tuple_type = std::tuple<Containers...>;
 
+    static constexpr bool all_sized = (std::ranges::sized_range<Containers> && ...);
+
 public:
+    // Values computed all at once by a vector kernel in materialize_into
+    static constexpr bool batched = detail::batched_v<Func, Containers...>;
+
+    using value_type = std::remove_cvref_t<std::invoke_result_t<Func, std::ranges::range_reference_t<Containers>...>>;
+
     constexpr zip_with() = default;
     explicit constexpr zip_with(Func func, Containers... containers)
         : m_func{func}
@@ -84,6 +153,32 @@ public:
     constexpr auto begin() { return iterator{m_func, m_data}; }
     constexpr auto end() { return typename iterator::sentinel{}; }
 
+    // Size of the shortest container
+    [[nodiscard]] constexpr auto size() requires all_sized {
+        return std::apply([](auto &...containers) {
+            using size_type = std::make_unsigned_t<std::common_type_t<std::ranges::range_size_t<Containers>...>>;
+            return std::min({static_cast<size_type>(std::ranges::size(containers))...});
+        },
+                          m_data);
+    }
+
+    // Writes the first min(size(), out.size()) values into out and returns them. Two contiguous
+    // arithmetic ranges combined by an operator_sections callable (plus, _ * _, ...) are computed
+    // by a vector kernel for the instruction set of the CPU.
+    std::span<value_type> materialize_into(std::span<value_type> out) requires all_sized {
+        auto const written = out.first(std::min(static_cast<std::size_t>(size()), out.size()));
+        if constexpr (batched) {
+            using element_type = value_type const;
+            auto &[lhs, rhs] = m_data;
+            detail::simd::transform<detail::section_op<Func>::value>(std::span<element_type>{std::ranges::data(lhs), written.size()},
+                                                                     std::span<element_type>{std::ranges::data(rhs), written.size()},
+                                                                     written);
+        } else {
+            std::ranges::copy_n(begin(), static_cast<std::ptrdiff_t>(written.size()), written.begin());
+        }
+        return written;
+    }
+
 private:
     Func m_func;
     tuple_type m_data;
@@ -0,0 +1,125 @@
+#ifndef CPPUTILS_INTERNAL_COMMON_TUPLE_HPP
+#define CPPUTILS_INTERNAL_COMMON_TUPLE_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace cpputils::detail {
+
+// Tuple of references usable as the reference type of a proxy iterator: it converts from and
+// assigns to tuples of values element by element, assigns through a const object, and has a common
+// reference with the tuple of values (what std::tuple only provides from C++23)
+template <typename... Ts>
+class common_tuple : public std::tuple<Ts...> {
+    using base_t = std::tuple<Ts...>;
+
+public:
+    constexpr common_tuple() = default;
+
+    // clang-format off
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::constructible_from<Ts, Us> && ...)
+    explicit constexpr common_tuple(std::in_place_t, Us &&...values)
+        : base_t(std::forward<Us>(values)...) {}
+
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::constructible_from<Ts, Us &> && ...)
+    constexpr common_tuple(std::tuple<Us...> &other)  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        : common_tuple{other, std::index_sequence_for<Ts...>{}} {}
+
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::constructible_from<Ts, Us const &> && ...)
+    constexpr common_tuple(std::tuple<Us...> const &other)  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        : common_tuple{other, std::index_sequence_for<Ts...>{}} {}
+
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::constructible_from<Ts, Us> && ...)
+    constexpr common_tuple(std::tuple<Us...> &&other)  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        : common_tuple{std::move(other), std::index_sequence_for<Ts...>{}} {}
+
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::is_assignable_v<Ts &, Us const &> && ...)
+    constexpr common_tuple &operator=(std::tuple<Us...> const &other) {
+        assign(static_cast<base_t &>(*this), other, std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::is_assignable_v<Ts &, Us> && ...)
+    constexpr common_tuple &operator=(std::tuple<Us...> &&other) {
+        assign(static_cast<base_t &>(*this), std::move(other), std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    // Only tuples of references can be assigned through a const object
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::is_assignable_v<Ts const &, Us const &> && ...)
+    constexpr common_tuple const &operator=(std::tuple<Us...> const &other) const {
+        assign(static_cast<base_t const &>(*this), other, std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts)) && (std::is_assignable_v<Ts const &, Us> && ...)
+    constexpr common_tuple const &operator=(std::tuple<Us...> &&other) const {
+        assign(static_cast<base_t const &>(*this), std::move(other), std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    // Swaps the referenced values, which is what algorithms swapping *it expect
+    friend constexpr void swap(common_tuple const &lhs, common_tuple const &rhs)
+    requires(std::is_reference_v<Ts> && ...) && (std::swappable<Ts> && ...)
+    {
+        swap_each(lhs, rhs, std::index_sequence_for<Ts...>{});
+    }
+    // clang-format on
+
+private:
+    template <typename Tuple, std::size_t... I>
+    constexpr common_tuple(Tuple &&other, std::index_sequence<I...>)
+        : base_t(std::get<I>(std::forward<Tuple>(other))...) {}
+
+    template <typename Base, typename Tuple, std::size_t... I>
+    static constexpr void assign(Base &to, Tuple &&other, std::index_sequence<I...>) {
+        ((std::get<I>(to) = std::get<I>(std::forward<Tuple>(other))), ...);
+    }
+
+    template <std::size_t... I>
+    static constexpr void swap_each(common_tuple const &lhs, common_tuple const &rhs, std::index_sequence<I...>) {
+        (std::ranges::swap(std::get<I>(static_cast<base_t const &>(lhs)), std::get<I>(static_cast<base_t const &>(rhs))), ...);
+    }
+};
+
+}  // namespace cpputils::detail
+
+template <typename... Ts>
+struct std::tuple_size<::cpputils::detail::common_tuple<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, typename... Ts>
+struct std::tuple_element<I, ::cpputils::detail::common_tuple<Ts...>> : std::tuple_element<I, std::tuple<Ts...>> {};
+
+// clang-format off
+template <typename... Ts, typename... Us, template <typename> class TQual, template <typename> class UQual>
+requires(sizeof...(Ts) == sizeof...(Us)) && requires { typename ::cpputils::detail::common_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>; }
+struct std::basic_common_reference<::cpputils::detail::common_tuple<Ts...>, ::cpputils::detail::common_tuple<Us...>, TQual, UQual> {
+    using type = ::cpputils::detail::common_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+
+template <typename... Ts, typename... Us, template <typename> class TQual, template <typename> class UQual>
+requires(sizeof...(Ts) == sizeof...(Us)) && requires { typename ::cpputils::detail::common_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>; }
+struct std::basic_common_reference<::cpputils::detail::common_tuple<Ts...>, std::tuple<Us...>, TQual, UQual> {
+    using type = ::cpputils::detail::common_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+
+template <typename... Ts, typename... Us, template <typename> class TQual, template <typename> class UQual>
+requires(sizeof...(Ts) == sizeof...(Us)) && requires { typename ::cpputils::detail::common_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>; }
+struct std::basic_common_reference<std::tuple<Ts...>, ::cpputils::detail::common_tuple<Us...>, TQual, UQual> {
+    using type = ::cpputils::detail::common_tuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+// clang-format on
+
+#endif
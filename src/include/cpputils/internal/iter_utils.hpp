@@ -6,6 +6,7 @@
 #include <iterator>
 #include <ranges>
 #include <tuple>
+#include <type_traits>
 
 
 namespace cpputils::detail {
@@ -16,6 +17,30 @@ using tuple_ref = std::tuple<std::ranges::range_reference_t<Iterables>...>;
 template <std::ranges::input_range... Iterables>
 using tuple_iter = std::tuple<std::ranges::iterator_t<Iterables>...>;
 
+template <std::ranges::input_range... Iterables>
+using tuple_ptr = std::tuple<std::add_pointer_t<std::ranges::range_reference_t<Iterables>>...>;
+
+// Placeholder for members that are not used by a specialization, Id keeps the addresses distinct
+template <std::size_t Id>
+struct empty_t {};
+
+// Strongest iterator category modelled by all the ranges
+template <std::ranges::input_range... Iterables>
+consteval auto common_iterator_concept() {
+    if constexpr ((std::ranges::random_access_range<Iterables> && ...)) {
+        return std::random_access_iterator_tag{};
+    } else if constexpr ((std::ranges::bidirectional_range<Iterables> && ...)) {
+        return std::bidirectional_iterator_tag{};
+    } else if constexpr ((std::ranges::forward_range<Iterables> && ...)) {
+        return std::forward_iterator_tag{};
+    } else {
+        return std::input_iterator_tag{};
+    }
+}
+
+template <std::ranges::input_range... Iterables>
+using common_iterator_concept_t = decltype(common_iterator_concept<Iterables...>());
+
 template <typename... Objects>
 constexpr auto iseq() { return std::make_index_sequence<sizeof...(Objects)>{}; }
 
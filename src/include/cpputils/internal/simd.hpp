@@ -0,0 +1,157 @@
+#ifndef CPPUTILS_INTERNAL_SIMD_HPP
+#define CPPUTILS_INTERNAL_SIMD_HPP
+
+#include "../misc/system_macros.hpp"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+// Vector kernels are written with the GCC/Clang vector extensions and compiled for each instruction
+// set through target attributes, the best one is picked at run time. Other compilers and platforms
+// get the scalar loop.
+#if defined(CPPUTILS_X86_PLATFORM) && (defined(__GNUC__) || defined(__clang__))
+#define CPPUTILS_SIMD_DISPATCH
+#endif
+
+namespace cpputils::detail::simd {
+
+enum class arithmetic_op : std::uint8_t {
+    plus,
+    minus,
+    multiplies,
+    divides,
+    bit_and,
+    bit_or,
+    bit_xor,
+};
+
+enum class isa : std::uint8_t {
+    scalar,
+    sse2,
+    avx2,
+};
+
+// Integer division has no vector instruction, bitwise operations need integers
+template <arithmetic_op Op, typename T>
+concept vectorizable = std::is_arithmetic_v<T> && !std::same_as<T, bool>
+                       && (std::floating_point<T> ? (Op != arithmetic_op::bit_and && Op != arithmetic_op::bit_or && Op != arithmetic_op::bit_xor)
+                                                  : Op != arithmetic_op::divides);
+
+// The best instruction set of the running CPU, detected once
+[[nodiscard]] inline isa detected_isa() noexcept {
+#ifdef CPPUTILS_SIMD_DISPATCH
+    static isa const detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) { return isa::avx2; }
+        if (__builtin_cpu_supports("sse2")) { return isa::sse2; }
+        return isa::scalar;
+    }();
+    return detected;
+#else
+    return isa::scalar;
+#endif
+}
+
+template <arithmetic_op Op, typename T>
+[[gnu::always_inline]] inline T apply(T const &lhs, T const &rhs) noexcept {
+    if constexpr (Op == arithmetic_op::plus) {
+        return static_cast<T>(lhs + rhs);
+    } else if constexpr (Op == arithmetic_op::minus) {
+        return static_cast<T>(lhs - rhs);
+    } else if constexpr (Op == arithmetic_op::multiplies) {
+        return static_cast<T>(lhs * rhs);
+    } else if constexpr (Op == arithmetic_op::divides) {
+        return static_cast<T>(lhs / rhs);
+    } else if constexpr (Op == arithmetic_op::bit_and) {
+        return static_cast<T>(lhs & rhs);
+    } else if constexpr (Op == arithmetic_op::bit_or) {
+        return static_cast<T>(lhs | rhs);
+    } else {
+        return static_cast<T>(lhs ^ rhs);
+    }
+}
+
+template <arithmetic_op Op, typename T>
+void scalar_kernel(T const *lhs, T const *rhs, T *out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = apply<Op>(lhs[i], rhs[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+}
+
+#ifdef CPPUTILS_SIMD_DISPATCH
+// Bytes wide blocks, then the scalar loop for the tail
+template <std::size_t Bytes, arithmetic_op Op, typename T>
+[[gnu::always_inline]] inline void vector_loop(T const *lhs, T const *rhs, T *out, std::size_t n) noexcept {
+    typedef T vec_t __attribute__((vector_size(Bytes)));  // NOLINT(modernize-use-using)
+    constexpr std::size_t width = Bytes / sizeof(T);
+    std::size_t i = 0;
+    for (; i + width <= n; i += width) {
+        vec_t a;
+        vec_t b;
+        std::memcpy(&a, lhs + i, Bytes);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(&b, rhs + i, Bytes);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        vec_t result;
+        if constexpr (Op == arithmetic_op::plus) {
+            result = a + b;
+        } else if constexpr (Op == arithmetic_op::minus) {
+            result = a - b;
+        } else if constexpr (Op == arithmetic_op::multiplies) {
+            result = a * b;
+        } else if constexpr (Op == arithmetic_op::divides) {
+            result = a / b;
+        } else if constexpr (Op == arithmetic_op::bit_and) {
+            result = a & b;
+        } else if constexpr (Op == arithmetic_op::bit_or) {
+            result = a | b;
+        } else {
+            result = a ^ b;
+        }
+        std::memcpy(out + i, &result, Bytes);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    for (; i < n; ++i) {
+        out[i] = apply<Op>(lhs[i], rhs[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+}
+
+template <arithmetic_op Op, typename T>
+[[gnu::target("sse2")]] void sse2_kernel(T const *lhs, T const *rhs, T *out, std::size_t n) noexcept {
+    vector_loop<16, Op>(lhs, rhs, out, n);  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+}
+
+template <arithmetic_op Op, typename T>
+[[gnu::target("avx2")]] void avx2_kernel(T const *lhs, T const *rhs, T *out, std::size_t n) noexcept {
+    vector_loop<32, Op>(lhs, rhs, out, n);  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+}
+#endif
+
+// out[i] = lhs[i] Op rhs[i] for the first out.size() elements, with the given instruction set.
+// Instruction sets the CPU does not support fall back to the detected one.
+template <arithmetic_op Op, typename T>
+requires vectorizable<Op, T>
+void transform(std::span<T const> lhs, std::span<T const> rhs, std::span<T> out, isa set) noexcept {
+    auto const n = out.size();
+#ifdef CPPUTILS_SIMD_DISPATCH
+    if (set > detected_isa()) { set = detected_isa(); }
+    switch (set) {
+    case isa::avx2: avx2_kernel<Op>(lhs.data(), rhs.data(), out.data(), n); return;
+    case isa::sse2: sse2_kernel<Op>(lhs.data(), rhs.data(), out.data(), n); return;
+    case isa::scalar: break;
+    }
+#else
+    static_cast<void>(set);
+#endif
+    scalar_kernel<Op>(lhs.data(), rhs.data(), out.data(), n);
+}
+
+template <arithmetic_op Op, typename T>
+requires vectorizable<Op, T>
+void transform(std::span<T const> lhs, std::span<T const> rhs, std::span<T> out) noexcept {
+    transform<Op>(lhs, rhs, out, detected_isa());
+}
+
+}  // namespace cpputils::detail::simd
+
+#endif
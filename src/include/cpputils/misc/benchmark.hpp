@@ -1,34 +1,78 @@
 #ifndef CPPUTILS_BENCHMARK_HPP
 #define CPPUTILS_BENCHMARK_HPP
 
-#include "../functional/opt_ext.hpp"
 #include "../meta/traits.hpp"
+#include "../types/static_string.hpp"
+#include "system_macros.hpp"
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <charconv>
 #include <chrono>
+#include <cmath>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <functional>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef CPPUTILS_POSIX_PLATFORM
+#include <cerrno>
+#include <unistd.h>
+#endif
 
 // NOLINTNEXTLINE
 #define FWD(x) std::forward<decltype(x)>(x)
 
 namespace cpputils::benchmark {
 
+namespace detail {
+    // Used only to check that a record can be visited field by field
+    struct field_visitor_archetype {
+        void operator()(std::string_view, auto const &) const {}
+    };
+}  // namespace detail
+
+// A record aggregates the samples logged for a section (e.g. statistics or histograms)
+// instead of keeping only the last one.
+template <typename R>
+concept time_record =
+    std::default_initializable<R>
+    && std::copyable<R>
+    && duration<typename R::duration_t>
+    && requires (R r, R const cr, typename R::duration_t d) {
+           r.record(d);
+           { cr.elapsed() } -> std::convertible_to<typename R::duration_t>;
+           cr.for_each_field(detail::field_visitor_archetype{});
+       };
+
+template <typename T>
+concept loggable = duration<T> || time_record<T>;
+
 template <typename V>
 concept logger_range_value =
     pair_like<V>
     && std::same_as<std::remove_cvref_t<decltype(std::declval<V>().first)>, std::string>
-    && duration<std::remove_cvref_t<decltype(std::declval<V>().second)>>;
+    && loggable<std::remove_cvref_t<decltype(std::declval<V>().second)>>;
 
 template <typename L>
 concept time_logger =
@@ -38,9 +82,24 @@ concept time_logger =
        }  //
     && std::movable<L>  //
     && std::copyable<L>  //
-    && duration<typename L::mapped_type>  //
+    && loggable<typename L::mapped_type>  //
     && std::ranges::input_range<L>;
 
+namespace detail {
+    template <loggable T>
+    struct logged_duration {
+        using type = T;
+    };
+
+    template <time_record T>
+    struct logged_duration<T> {
+        using type = typename T::duration_t;
+    };
+
+    template <loggable T>
+    using logged_duration_t = typename logged_duration<T>::type;
+}  // namespace detail
+
 template <typename C>
 concept time_counter =
     std::default_initializable<C>
@@ -54,9 +113,221 @@ template <typename Counter, typename Logger>
 concept time_counter_compatible_delta =
     time_logger<Logger>
     && requires (Counter c) {
-           { c.delta() } -> std::convertible_to<typename Logger::mapped_type>;
+           { c.delta() } -> std::convertible_to<detail::logged_duration_t<typename Logger::mapped_type>>;
        };
 
+// A measure standing for `weight` calls of a section, of which only one was timed
+template <duration D>
+struct weighted_sample {
+    D elapsed{};
+    std::uint64_t weight{1};
+};
+
+// Work done by a measured section: items processed and bytes read or written
+struct processed {
+    std::uint64_t items{};
+    std::uint64_t bytes{};
+};
+
+// A measure of a section together with the work it did
+template <typename Sample>
+struct processed_sample {
+    Sample sample{};
+    processed work{};
+};
+
+namespace detail {
+    // Counters can expose a richer measurement than delta() (e.g. hardware counters): it is logged
+    // when the record accepts it, otherwise only the elapsed time is
+    template <loggable T, time_counter Counter>
+    [[nodiscard]] auto sample_of(Counter const &counter) {
+        if constexpr (time_record<T> && requires (T slot) { slot.record(counter.measurement()); }) {
+            return counter.measurement();
+        } else {
+            return logged_duration_t<T>{counter.delta()};
+        }
+    }
+
+    // Sampled measures are logged with their weight when the record accepts it, otherwise as
+    // a plain sample
+    template <loggable T, time_counter Counter>
+    [[nodiscard]] auto weighted_sample_of(Counter const &counter, std::uint64_t weight) {
+        using sample_t = weighted_sample<logged_duration_t<T>>;
+        if constexpr (time_record<T> && requires (T slot) { slot.record(sample_t{}); }) {
+            return sample_t{.elapsed = logged_duration_t<T>{counter.delta()}, .weight = weight};
+        } else {
+            return sample_of<T>(counter);
+        }
+    }
+
+    // The work of a section is logged only if the record accepts it
+    template <loggable T, typename Sample>
+    [[nodiscard]] auto with_work(Sample const &sample, processed work) {
+        if constexpr (time_record<T> && requires (T slot) { slot.record(processed_sample<Sample>{}); }) {
+            return processed_sample<Sample>{.sample = sample, .work = work};
+        } else {
+            return sample;
+        }
+    }
+
+    // Plain durations are overwritten, records accumulate the new sample
+    template <loggable T, typename Sample>
+    void log_sample(T &slot, Sample const &sample) {
+        if constexpr (time_record<T>) {
+            slot.record(sample);
+        } else {
+            slot = sample;
+        }
+    }
+
+    // Loggers can take over the whole update (e.g. to synchronize it) by providing record(key, sample)
+    template <time_logger Logger, typename Sample>
+    void log_into(Logger &logger, std::string const &key, Sample const &sample) {
+        if constexpr (requires { logger.record(key, sample); }) {
+            logger.record(key, sample);
+        } else {
+            log_sample(logger[key], sample);
+        }
+    }
+
+    // Loggers can be told when a section starts by providing on_start(key)
+    template <time_logger Logger>
+    void notify_start(Logger &logger, std::string const &key) {
+        if constexpr (requires { logger.on_start(key); }) {
+            logger.on_start(key);
+        }
+    }
+
+    template <loggable T>
+    [[nodiscard]] logged_duration_t<T> elapsed_of(T const &value) {
+        if constexpr (time_record<T>) {
+            return value.elapsed();
+        } else {
+            return value;
+        }
+    }
+
+    template <duration D>
+    [[nodiscard]] D duration_from_count(double count) {
+        if constexpr (std::chrono::treat_as_floating_point_v<typename D::rep>) {
+            return D{static_cast<typename D::rep>(count)};
+        } else {
+            return D{static_cast<typename D::rep>(std::llround(count))};
+        }
+    }
+
+    // Number and mean elapsed time of the measures of a section. Records measuring more than the time
+    // derive from it and add their own counters.
+    template <duration D>
+    class mean_record {
+    public:
+        using duration_t = D;
+
+        void record(D elapsed) {
+            ++m_count;
+            m_total += elapsed;
+        }
+
+        void merge(mean_record const &other) {
+            m_count += other.m_count;
+            m_total += other.m_total;
+        }
+
+        [[nodiscard]] std::uint64_t count() const noexcept { return m_count; }
+
+        [[nodiscard]] D elapsed() const {
+            if (m_count == 0U) { return D{}; }
+            return duration_from_count<D>(static_cast<double>(m_total.count()) / static_cast<double>(m_count));
+        }
+
+    private:
+        std::uint64_t m_count{};
+        D m_total{};
+    };
+
+#ifdef _MSC_VER
+    // MSVC has no inline assembly on x64: publishing the address through a volatile pointer
+    // forces the object to be materialized in memory
+    inline void const *volatile escaped_address{};
+#endif
+}  // namespace detail
+
+// The compiler must assume that value is read and written by unknown code: computations whose
+// only result is value are not optimized away, and value is not copied.
+template <typename T>
+inline void do_not_optimize(T &&value) noexcept {
+#ifdef _MSC_VER
+    detail::escaped_address = std::addressof(value);
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "g"(std::addressof(value)) : "memory");
+#endif
+}
+
+// The compiler must assume that all memory is read and written here: pending writes (e.g. side
+// effects of a benchmarked function) are not optimized away nor moved across this point.
+inline void clobber_memory() noexcept {
+#ifdef _MSC_VER
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+namespace detail {
+    // Keep the result and the side effects of a benchmarked call so that the call is not optimized away
+    void invoke_and_keep(auto &&f, auto &&...args) {
+        if constexpr (std::is_same_v<std::invoke_result_t<decltype(f), decltype(args)...>, void>) {
+            std::invoke(FWD(f), FWD(args)...);
+            clobber_memory();
+        } else {
+            auto &&result = std::invoke(FWD(f), FWD(args)...);
+            do_not_optimize(result);
+        }
+    }
+}  // namespace detail
+
+namespace detail {
+    // Loggers whose slots are never moved by an insertion
+    template <typename Logger>
+    concept stable_slots = an<Logger, std::unordered_map> || an<Logger, std::map>;
+
+    template <loggable T>
+    class direct_slot {
+    public:
+        explicit direct_slot(T &slot)
+            : m_slot{&slot} {}
+
+        void record(auto const &sample) {
+            log_sample(*m_slot, sample);
+        }
+
+    private:
+        T *m_slot;
+    };
+}  // namespace detail
+
+// Loggers whose slot for a section can be looked up once and then written directly.
+// A logger can provide its own handle via resolve(key).
+template <typename L>
+concept section_logger =
+    time_logger<L>
+    && (detail::stable_slots<L>
+        || requires (L logger, std::string const &key) {
+               logger.resolve(key).record(std::declval<detail::logged_duration_t<typename L::mapped_type>>());
+           });
+
+namespace detail {
+    template <section_logger Logger>
+    [[nodiscard]] auto resolve_slot(Logger &logger, std::string const &key) {
+        if constexpr (requires { logger.resolve(key); }) {
+            return logger.resolve(key);
+        } else {
+            return direct_slot<typename Logger::mapped_type>{logger[key]};
+        }
+    }
+}  // namespace detail
+
 template <time_logger Logger>
 requires std::default_initializable<Logger>
 Logger &get_static_logger() {
@@ -73,11 +344,11 @@ public:
     using clock_t = Clock;
 
     void start() {
-        m_start = std::chrono::steady_clock::now();
+        m_start = Clock::now();
     }
 
     void stop() {
-        m_stop = std::chrono::steady_clock::now();
+        m_stop = Clock::now();
     }
 
     [[nodiscard]] duration auto delta() const {
@@ -92,6 +363,161 @@ private:
 template <duration D = default_duration>
 using default_logger = std::unordered_map<std::string, D>;
 
+// Decides which calls of a section are timed: one every n calls, or about one per interval
+// whatever the call rate. Skipping a call only decrements a counter, so a sampler is meant to be
+// thread_local and used by a single call site.
+class sampler {
+    using clock_t = std::chrono::steady_clock;
+
+public:
+    explicit sampler(std::uint64_t one_in)
+        : m_period{std::max(one_in, std::uint64_t{1})}
+        , m_countdown{m_period} {}
+
+    explicit sampler(duration auto interval)
+        : m_interval{std::chrono::duration_cast<std::chrono::nanoseconds>(interval)}
+        , m_last{clock_t::now()} {}
+
+    // True if this call must be timed
+    [[nodiscard]] bool sample() noexcept {
+        if (--m_countdown != 0U) { return false; }
+        m_weight = m_period;
+        rearm();
+        return true;
+    }
+
+    // Number of calls the last sampled one stands for
+    [[nodiscard]] std::uint64_t weight() const noexcept { return m_weight; }
+
+private:
+    std::uint64_t m_period{1};
+    std::uint64_t m_countdown{1};
+    std::uint64_t m_weight{};
+    std::chrono::nanoseconds m_interval{};
+    clock_t::time_point m_last{};
+
+    // With an interval, the next period is the number of calls expected in an interval at the
+    // rate observed since the previous sample. It at most doubles, a burst of calls in a short
+    // time is not a reliable rate.
+    void rearm() noexcept {
+        if (m_interval > std::chrono::nanoseconds{}) {
+            auto const now = clock_t::now();
+            auto const elapsed = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last), std::chrono::nanoseconds{1});
+            m_last = now;
+            auto const expected = static_cast<double>(m_period) * static_cast<double>(m_interval.count()) / static_cast<double>(elapsed.count());
+            m_period = static_cast<std::uint64_t>(std::clamp(expected, 1.0, 2.0 * static_cast<double>(m_period)));
+        }
+        m_countdown = m_period;
+    }
+};
+
+// Record of a sampled section. Every sample is scaled by its weight: calls and total are
+// estimates of all the calls, timed or not, and elapsed is the mean time of a call.
+template <duration D = default_duration>
+class sampled_record {
+public:
+    using duration_t = D;
+
+    void record(D elapsed) {
+        record(weighted_sample<D>{.elapsed = elapsed});
+    }
+
+    template <duration E>
+    void record(weighted_sample<E> const &sample) {
+        ++m_samples;
+        m_calls += sample.weight;
+        m_total += std::chrono::duration<double, typename D::period>{sample.elapsed}.count() * static_cast<double>(sample.weight);
+    }
+
+    void merge(sampled_record const &other) {
+        m_samples += other.m_samples;
+        m_calls += other.m_calls;
+        m_total += other.m_total;
+    }
+
+    [[nodiscard]] std::uint64_t samples() const noexcept { return m_samples; }
+    [[nodiscard]] std::uint64_t calls() const noexcept { return m_calls; }
+    [[nodiscard]] D total() const { return detail::duration_from_count<D>(m_total); }
+
+    [[nodiscard]] D elapsed() const {
+        if (m_calls == 0U) { return D{}; }
+        return detail::duration_from_count<D>(m_total / static_cast<double>(m_calls));
+    }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"samples"}, samples());
+        f(std::string_view{"calls"}, calls());
+        f(std::string_view{"total"}, total());
+        f(std::string_view{"mean"}, elapsed());
+    }
+
+private:
+    std::uint64_t m_samples{};
+    std::uint64_t m_calls{};
+    double m_total{};
+};
+
+template <duration D = default_duration>
+using sampled_logger = std::unordered_map<std::string, sampled_record<D>>;
+
+// Adds the work done to the measures of another record: items() and bytes() are the mean work of
+// the measures that reported it. Reports derive items_per_second and bytes_per_second from them.
+template <time_record R>
+class with_throughput {
+public:
+    using duration_t = typename R::duration_t;
+
+    template <typename Sample>
+    requires requires (R r, Sample const &sample) { r.record(sample); }
+    void record(Sample const &sample) {
+        m_record.record(sample);
+    }
+
+    template <typename Sample>
+    requires requires (R r, Sample const &sample) { r.record(sample); }
+    void record(processed_sample<Sample> const &sample) {
+        m_record.record(sample.sample);
+        ++m_measures;
+        m_items += sample.work.items;
+        m_bytes += sample.work.bytes;
+    }
+
+    void merge(with_throughput const &other) requires requires (R r) { r.merge(r); }
+    {
+        m_record.merge(other.m_record);
+        m_measures += other.m_measures;
+        m_items += other.m_items;
+        m_bytes += other.m_bytes;
+    }
+
+    [[nodiscard]] R const &base() const noexcept { return m_record; }
+
+    [[nodiscard]] duration_t elapsed() const { return m_record.elapsed(); }
+
+    [[nodiscard]] double items() const { return per_measure(m_items); }
+    [[nodiscard]] double bytes() const { return per_measure(m_bytes); }
+
+    void for_each_field(auto &&f) const {
+        m_record.for_each_field(f);
+        f(std::string_view{"items"}, items());
+        f(std::string_view{"bytes"}, bytes());
+    }
+
+private:
+    R m_record{};
+    std::uint64_t m_measures{};
+    std::uint64_t m_items{};
+    std::uint64_t m_bytes{};
+
+    [[nodiscard]] double per_measure(std::uint64_t total) const {
+        if (m_measures == 0U) { return 0.0; }
+        return static_cast<double>(total) / static_cast<double>(m_measures);
+    }
+};
+
+template <time_record R>
+using throughput_logger = std::unordered_map<std::string, with_throughput<R>>;
+
 template <time_logger Logger = default_logger<>, time_counter TimeCounter = default_counter<>>
 requires time_counter_compatible_delta<TimeCounter, Logger>
 class timer {
@@ -99,25 +525,78 @@ public:
     using logger_t = Logger;
     using time_counter_t = TimeCounter;
 
+    // A section of a logger whose slot has already been looked up: timing it does not build or
+    // hash the name again. The slot stays valid as long as the logger is alive.
+    class section {
+    public:
+        section(Logger &logger, std::string const &name) requires section_logger<Logger>
+            : m_logger{logger}
+            , m_slot{detail::resolve_slot(logger, name)} {}
+
+        void record(auto const &sample) {
+            m_slot.record(sample);
+        }
+
+        [[nodiscard]] Logger &logger() const noexcept { return m_logger; }
+
+    private:
+        std::reference_wrapper<Logger> m_logger;
+        decltype(detail::resolve_slot(std::declval<Logger &>(), std::declval<std::string const &>())) m_slot;
+    };
+
     timer()
         : m_logger{get_static_logger<Logger>()} {}
 
     explicit timer(Logger &logger)
         : m_logger{logger} {}
 
+    // Section of the static logger, looked up the first time it is used by each thread. Lookups from
+    // several threads insert into the same logger without synchronization: a Logger used from more
+    // than one thread must be thread-safe (e.g. concurrent_logger).
+    template <static_string Name>
+    [[nodiscard]] static section &static_section() requires section_logger<Logger> && std::default_initializable<Logger>
+    {
+        thread_local section s{get_static_logger<Logger>(), std::string{std::string_view{Name}}};
+        return s;
+    }
+
 
     void start(std::string msg) {
         assert(!m_active);
         m_active = true;
         m_message = std::move(msg);
+        detail::notify_start(m_logger.get(), m_message);
+        m_time_counter.start();
+    }
+
+    void start(section &s) {
+        assert(!m_active);
+        m_active = true;
+        m_section = &s;
         m_time_counter.start();
     }
 
+    // The work is logged with the measure, if the record keeps it (see with_throughput)
+    void start(std::string msg, processed work) {
+        start(std::move(msg));
+        m_work = work;
+    }
+
+    void start(section &s, processed work) {
+        start(s);
+        m_work = work;
+    }
+
     void stop() {
         assert(m_active);
         m_time_counter.stop();
         m_active = false;
-        m_logger.get()[m_message] = m_time_counter.delta();
+        auto const sample = detail::sample_of<typename Logger::mapped_type>(m_time_counter);
+        if (m_work) {
+            log(detail::with_work<typename Logger::mapped_type>(sample, *std::exchange(m_work, std::nullopt)));
+        } else {
+            log(sample);
+        }
     }
 
     Logger const &logger() const noexcept {
@@ -127,16 +606,15 @@ public:
     duration auto benchmark_this(std::string msg, auto &&f, auto &&...args)
         requires std::invocable<decltype(f), decltype(args)...>
     {
-#define BENCHMARK_FUNCTION_CALL() std::invoke(FWD(f), FWD(args)...) /* NOLINT */
         start(std::move(msg));
-        if constexpr (std::is_same_v<decltype(BENCHMARK_FUNCTION_CALL()), void>) {
-            BENCHMARK_FUNCTION_CALL();
-        } else {
-            [[maybe_unused]] volatile auto const r = BENCHMARK_FUNCTION_CALL();
-        }
-        stop();
-#undef BENCHMARK_FUNCTION_CALL
-        return m_time_counter.delta();
+        return invoke_and_stop(FWD(f), FWD(args)...);
+    }
+
+    duration auto benchmark_this(std::string msg, processed work, auto &&f, auto &&...args)
+        requires std::invocable<decltype(f), decltype(args)...>
+    {
+        start(std::move(msg), work);
+        return invoke_and_stop(FWD(f), FWD(args)...);
     }
 
     class scoped {
@@ -146,6 +624,21 @@ public:
             m_timeit.start(std::move(msg));
         }
 
+        explicit scoped(section &s)
+            : m_timeit{s.logger()} {
+            m_timeit.start(s);
+        }
+
+        scoped(Logger &logger_, std::string msg, processed work)
+            : m_timeit{logger_} {
+            m_timeit.start(std::move(msg), work);
+        }
+
+        scoped(section &s, processed work)
+            : m_timeit{s.logger()} {
+            m_timeit.start(s, work);
+        }
+
         ~scoped() {
             m_timeit.stop();
         }
@@ -159,11 +652,79 @@ public:
         timer m_timeit;
     };
 
+    // Times only the calls chosen by a sampler, each one logged with the number of calls it
+    // stands for. The name is copied only when the call is sampled.
+    class sampled {
+    public:
+        sampled(Logger &logger_, std::string_view msg, sampler &s)
+            : m_timeit{logger_} {
+            if (s.sample()) {
+                m_weight = s.weight();
+                m_timeit.start(std::string{msg});
+            }
+        }
+
+        sampled(section &sec, sampler &s)
+            : m_timeit{sec.logger()} {
+            if (s.sample()) {
+                m_weight = s.weight();
+                m_timeit.start(sec);
+            }
+        }
+
+        ~sampled() {
+            if (m_weight != 0U) { m_timeit.stop_sampled(m_weight); }
+        }
+
+        sampled(sampled const &) = delete;
+        sampled(sampled &&) = delete;
+        sampled &operator=(sampled const &) = delete;
+        sampled &operator=(sampled &&) = delete;
+
+    private:
+        timer m_timeit;
+        std::uint64_t m_weight{};
+    };
+
 private:
     std::reference_wrapper<Logger> m_logger;
     TimeCounter m_time_counter{};
     std::string m_message{};
+    section *m_section{nullptr};
+    std::optional<processed> m_work{};
     bool m_active{false};
+
+    duration auto invoke_and_stop(auto &&f, auto &&...args) {
+        if constexpr (std::is_same_v<std::invoke_result_t<decltype(f), decltype(args)...>, void>) {
+            std::invoke(FWD(f), FWD(args)...);
+            clobber_memory();
+            stop();
+        } else {
+            // The result is destroyed after the measure
+            auto &&result = std::invoke(FWD(f), FWD(args)...);
+            do_not_optimize(result);
+            stop();
+        }
+        return m_time_counter.delta();
+    }
+
+    void stop_sampled(std::uint64_t weight) {
+        assert(m_active);
+        m_time_counter.stop();
+        m_active = false;
+        log(detail::weighted_sample_of<typename Logger::mapped_type>(m_time_counter, weight));
+    }
+
+    void log(auto const &sample) {
+        if constexpr (section_logger<Logger>) {
+            if (m_section != nullptr) {
+                m_section->record(sample);
+                m_section = nullptr;
+                return;
+            }
+        }
+        detail::log_into(m_logger.get(), m_message, sample);
+    }
 };
 
 template <typename L, typename F>
@@ -192,102 +753,355 @@ namespace detail {
             std::optional<std::string> local;
             std::optional<std::string> utc;
         };
-        auto const time_to_str = transform([](std::tm const &date_time) -> std::optional<std::string> {
-            auto const *str = std::asctime(&date_time);  // NOLINT
+        auto const time_to_str = [](std::optional<std::tm> const &date_time) -> std::optional<std::string> {
+            if (!date_time) { return std::nullopt; }
+            auto const *str = std::asctime(&date_time.value());  // NOLINT
             auto const *newline = static_cast<char const *>(std::memchr(str, '\n', 25));  // NOLINT See https://en.cppreference.com/w/cpp/chrono/c/asctime for the 25
             if (newline == nullptr) { return std::nullopt; }
             return std::string{str, newline};
-        });
+        };
 
         auto now_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
-        return local_and_utc{.local = cpputils_localtime(now_time) >> time_to_str,
-                             .utc = cpputils_gmtime(now_time) >> time_to_str};
+        return local_and_utc{.local = time_to_str(cpputils_localtime(now_time)),
+                             .utc = time_to_str(cpputils_gmtime(now_time))};
     }
 
+    // Only the period is checked, so that floating point durations are detected as well
     template <duration D>
     [[nodiscard]] consteval std::string_view detect_time_unit() {
-        if constexpr (std::is_same_v<D, std::chrono::nanoseconds>) {
+        using period = typename D::period;
+        if constexpr (std::is_same_v<period, std::chrono::nanoseconds::period>) {
             return "nanoseconds";
-        } else if constexpr (std::is_same_v<D, std::chrono::milliseconds>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::microseconds::period>) {
+            return "microseconds";
+        } else if constexpr (std::is_same_v<period, std::chrono::milliseconds::period>) {
             return "milliseconds";
-        } else if constexpr (std::is_same_v<D, std::chrono::seconds>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::seconds::period>) {
             return "seconds";
-        } else if constexpr (std::is_same_v<D, std::chrono::minutes>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::minutes::period>) {
             return "minutes";
-        } else if constexpr (std::is_same_v<D, std::chrono::hours>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::hours::period>) {
             return "hours";
-        } else if constexpr (std::is_same_v<D, std::chrono::days>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::days::period>) {
             return "days";
-        } else if constexpr (std::is_same_v<D, std::chrono::weeks>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::weeks::period>) {
             return "weeks";
-        } else if constexpr (std::is_same_v<D, std::chrono::months>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::months::period>) {
             return "months";
-        } else if constexpr (std::is_same_v<D, std::chrono::years>) {
+        } else if constexpr (std::is_same_v<period, std::chrono::years::period>) {
             return "years";
         } else {
             return "unknown";
         }
     }
 
-    // If logger is not sortable, copy the contents into a vector and sort it, otherwise just use logger
-    template <time_logger Logger>
-    [[nodiscard]] auto make_sorted(Logger logger) {
-        auto const sorter = [](auto const &lhs, auto const &rhs) { return rhs.second < lhs.second; };
-        if constexpr (requires { requires std::sortable<std::ranges::iterator_t<Logger>>; }) {
-            std::ranges::sort(logger, sorter);
-            return logger;
+    [[nodiscard]] inline std::string json_escape(std::string_view str) {
+        std::string escaped{};
+        escaped.reserve(str.size());
+        for (auto const c : str) {
+            switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20U) {  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+                    constexpr std::string_view hex_digits{"0123456789abcdef"};
+                    escaped += "\\u00";
+                    escaped += hex_digits[static_cast<unsigned char>(c) >> 4U];
+                    escaped += hex_digits[static_cast<unsigned char>(c) & 0xFU];  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+                } else {
+                    escaped += c;
+                }
+            }
+        }
+        return escaped;
+    }
+}  // namespace detail
+
+// Order of the records in a report: by elapsed time (slowest first) or as the logger iterates them
+enum class report_order : std::uint8_t {
+    by_elapsed,
+    as_logged,
+};
+
+// Destination of a streamed report
+template <typename S>
+concept report_sink = requires (S sink, std::string_view chunk) { sink.write(chunk); };
+
+class string_sink {
+public:
+    explicit string_sink(std::string &out)
+        : m_out{out} {}
+
+    void write(std::string_view chunk) { m_out.get() += chunk; }
+
+private:
+    std::reference_wrapper<std::string> m_out;
+};
+
+class ostream_sink {
+public:
+    explicit ostream_sink(std::ostream &out)
+        : m_out{out} {}
+
+    void write(std::string_view chunk) { m_out.get().write(chunk.data(), static_cast<std::streamsize>(chunk.size())); }
+
+private:
+    std::reference_wrapper<std::ostream> m_out;
+};
+
+#ifdef CPPUTILS_POSIX_PLATFORM
+// Writes to a file descriptor, which is not closed. After a write error the rest of the report is dropped.
+class fd_sink {
+public:
+    explicit fd_sink(int fd)
+        : m_fd{fd} {}
+
+    void write(std::string_view chunk) {
+        while (!chunk.empty() && !m_failed) {
+            auto const written = ::write(m_fd, chunk.data(), chunk.size());
+            if (written < 0) {
+                m_failed = errno != EINTR;
+                continue;
+            }
+            chunk.remove_prefix(static_cast<std::size_t>(written));
+        }
+    }
+
+    [[nodiscard]] bool failed() const noexcept { return m_failed; }
+
+private:
+    int m_fd;
+    bool m_failed{false};
+};
+#endif
+
+// Collects the text of a report in a fixed buffer and hands it to the sink a buffer at a time
+template <report_sink Sink>
+class report_writer {
+public:
+    static constexpr std::size_t buffer_size = 4096;
+
+    explicit report_writer(Sink &sink)
+        : m_sink{sink} {}
+
+    report_writer(report_writer const &) = delete;
+    report_writer(report_writer &&) = delete;
+    report_writer &operator=(report_writer const &) = delete;
+    report_writer &operator=(report_writer &&) = delete;
+
+    ~report_writer() { flush(); }
+
+    void write(std::string_view text) {
+        if (text.size() > buffer_size - m_size) {
+            flush();
+            if (text.size() >= buffer_size) {
+                m_sink.get().write(text);
+                return;
+            }
+        }
+        std::ranges::copy(text, std::next(m_buffer.begin(), static_cast<std::ptrdiff_t>(m_size)));
+        m_size += text.size();
+    }
+
+    void write(char c) {
+        if (m_size == buffer_size) { flush(); }
+        m_buffer[m_size++] = c;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    // Durations are written as their count
+    template <typename T>
+    requires duration<T> || std::is_arithmetic_v<T>
+    void write_number(T value) {
+        if constexpr (duration<T>) {
+            write_number(value.count());
+        } else {
+            if (buffer_size - m_size < max_number_size) { flush(); }
+            auto *const first = std::next(m_buffer.data(), static_cast<std::ptrdiff_t>(m_size));
+            auto const [last, error] = std::to_chars(first, std::next(m_buffer.data(), buffer_size), value);
+            assert(error == std::errc{});
+            m_size += static_cast<std::size_t>(last - first);
+        }
+    }
+
+    void flush() {
+        if (m_size == 0U) { return; }
+        m_sink.get().write(std::string_view{m_buffer.data(), m_size});
+        m_size = 0U;
+    }
+
+private:
+    // Enough for the shortest round trip representation of any integer or floating point number
+    static constexpr std::size_t max_number_size = 64;
+
+    std::reference_wrapper<Sink> m_sink;
+    std::array<char, buffer_size> m_buffer;  // NOLINT(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::size_t m_size{};
+};
+
+namespace detail {
+    template <typename R>
+    concept throughput_record =
+        time_record<R> && requires (R const r) {
+                              { r.items() } -> std::convertible_to<double>;
+                              { r.bytes() } -> std::convertible_to<double>;
+                          };
+
+    // The fields of a record followed by the ones derived for the report: items_per_second and
+    // bytes_per_second for records that keep the work done
+    template <time_record R>
+    void for_each_reported_field(R const &record, auto &&f) {
+        record.for_each_field(f);
+        if constexpr (throughput_record<R>) {
+            auto const seconds = std::chrono::duration<double>{record.elapsed()}.count();
+            f(std::string_view{"items_per_second"}, static_cast<double>(record.items()) / seconds);
+            f(std::string_view{"bytes_per_second"}, static_cast<double>(record.bytes()) / seconds);
+        }
+    }
+
+    template <loggable T>
+    [[nodiscard]] std::vector<std::string_view> column_names() {
+        if constexpr (time_record<T>) {
+            std::vector<std::string_view> names{};
+            for_each_reported_field(T{}, [&names](std::string_view name, auto const &) { names.push_back(name); });
+            return names;
         } else {
-            std::vector<std::pair<std::string, typename Logger::mapped_type>> copied_elements;
-            if constexpr (std::ranges::sized_range<Logger>) {
-                copied_elements.reserve(std::ranges::size(logger));
+            return {"elapsed_time"};
+        }
+    }
+
+    // How the fields of a record are laid out by a formatter
+    struct record_layout {
+        std::string_view open{};
+        std::string_view key_separator{};
+        std::string_view separator{};
+        std::string_view close{};
+        bool with_keys{true};
+        // Written before and after each key
+        std::string_view key_quote{};
+        // Written in place of nan and infinities, if not empty
+        std::string_view non_finite{};
+    };
+
+    template <report_sink Sink>
+    void write_field(report_writer<Sink> &out, auto const &field, record_layout const &layout) {
+        if constexpr (duration<std::remove_cvref_t<decltype(field)>>) {
+            write_field(out, field.count(), layout);
+        } else {
+            if constexpr (std::floating_point<std::remove_cvref_t<decltype(field)>>) {
+                if (!layout.non_finite.empty() && !std::isfinite(field)) {
+                    out.write(layout.non_finite);
+                    return;
+                }
             }
-            std::ranges::move(logger, std::back_inserter(copied_elements));
-            std::ranges::sort(copied_elements, sorter);
-            return copied_elements;
-        }
-    }
-
-    template <std::ranges::view V>
-    requires std::ranges::input_range<V> && std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<V>>, std::string>
-    [[nodiscard]] std::string join_with(std::string_view sep, V rng) {
-        auto const rng_size = std::ranges::size(rng);
-        auto iteration = decltype(rng_size){0};
-        auto report = std::string{};
-        for (auto const &record : rng) {
-            ++iteration;
-            if (iteration < rng_size) {
-                report += record + std::string{sep};
-            } else {
-                report += record;
+            out.write_number(field);
+        }
+    }
+
+    // A plain duration is written as a single value, a record as its list of fields
+    template <loggable T, report_sink Sink>
+    void write_value(report_writer<Sink> &out, T const &value, record_layout const &layout) {
+        if constexpr (time_record<T>) {
+            out.write(layout.open);
+            bool first{true};
+            for_each_reported_field(value, [&](std::string_view name, auto const &field) {
+                if (!first) { out.write(layout.separator); }
+                first = false;
+                if (layout.with_keys) {
+                    out.write(layout.key_quote);
+                    out.write(name);
+                    out.write(layout.key_quote);
+                    out.write(layout.key_separator);
+                }
+                write_field(out, field, layout);
+            });
+            out.write(layout.close);
+        } else {
+            write_field(out, value, layout);
+        }
+    }
+
+    // Only iterators to the entries are sorted, the records are never copied
+    template <std::ranges::forward_range Range>
+    void visit_entries(Range &entries, report_order order, auto &&f) {
+        if (order == report_order::as_logged) {
+            for (auto const &[key, value] : entries) {
+                f(key, value);
             }
+            return;
         }
-        return report;
+        std::vector<std::ranges::iterator_t<Range>> sorted{};
+        if constexpr (std::ranges::sized_range<Range>) {
+            sorted.reserve(std::ranges::size(entries));
+        }
+        for (auto it = std::ranges::begin(entries); it != std::ranges::end(entries); ++it) {
+            sorted.push_back(it);
+        }
+        std::ranges::sort(sorted, [](auto const &lhs, auto const &rhs) { return elapsed_of((*rhs).second) < elapsed_of((*lhs).second); });
+        for (auto const &it : sorted) {
+            auto const &[key, value] = *it;
+            f(key, value);
+        }
+    }
+
+    // f(key, value) for every entry of the logger. Loggers that can only be iterated when
+    // non-const (e.g. because they build a snapshot) are copied.
+    template <time_logger Logger>
+    void for_each_entry(Logger const &logger, report_order order, auto &&f) {
+        if constexpr (std::ranges::forward_range<Logger const>) {
+            visit_entries(logger, order, f);
+        } else {
+            auto copy = logger;
+            visit_entries(copy, order, f);
+        }
+    }
+
+    // parse()/get() of formatters that can be streamed: the report is written into a string
+    template <typename DerivedFormatter>
+    struct string_report {
+        template <typename Logger>
+        requires requires (DerivedFormatter f, Logger const &l, string_sink s) { f.write(l, s, report_order::by_elapsed); }
+        void parse(Logger const &logger) {
+            m_content.clear();
+            string_sink sink{m_content};
+            static_cast<DerivedFormatter &>(*this).write(logger, sink, report_order::by_elapsed);
+        }
+
+        [[nodiscard]] std::string_view get() const { return m_content; }
+
+    private:
+        std::string m_content{};
     };
 
     template <typename DerivedFormatter>
-    struct base_formatter {
-        template <time_logger Logger>
-        void parse(Logger logger) {
-            static constexpr auto time_unit = detect_time_unit<typename Logger::mapped_type>();
+    struct base_formatter : string_report<DerivedFormatter> {
+        template <time_logger Logger, report_sink Sink>
+        void write(Logger const &logger, Sink &sink, report_order order) {
+            using mapped_type = typename Logger::mapped_type;
+            static constexpr auto time_unit = detect_time_unit<logged_duration_t<mapped_type>>();
             auto &self = underlying();
-            self.start(time_unit);
-            std::ranges::input_range auto const sorted = detail::make_sorted(std::move(logger));
-            auto const time_values = sorted | std::views::transform([this](auto const &kv) { return underlying().process_data(kv); });
-            auto const records = join_with(self.separator(), time_values);
-            self.m_content += records;
-            self.finish();
+            report_writer out{sink};
+            if constexpr (requires { self.start(out, time_unit, column_names<mapped_type>()); }) {
+                self.start(out, time_unit, column_names<mapped_type>());
+            } else {
+                self.start(out, time_unit);
+            }
+            bool first{true};
+            for_each_entry(logger, order, [&](std::string const &key, mapped_type const &value) {
+                if (!first) { out.write(self.separator()); }
+                first = false;
+                self.write_record(out, key, value);
+            });
+            self.finish(out);
         }
 
-        [[nodiscard]] std::string_view get() const { return underlying().m_content; }
-
     private:
         DerivedFormatter &underlying() {
             return static_cast<DerivedFormatter &>(*this);
         }
-        [[nodiscard]] DerivedFormatter const &underlying() const {
-            return static_cast<DerivedFormatter const &>(*this);
-        }
     };
 }  // namespace detail
 
@@ -298,20 +1112,27 @@ namespace formatters {
         [[nodiscard]] static std::string_view type() noexcept { return "csv"; }
 
     private:
-        std::string m_content{};
         std::string m_unit_of_measure{};
 
         [[nodiscard]] static std::string_view separator() noexcept { return "\n"; }
 
-        void start(std::string_view unit_of_measure) {
+        void start(auto &out, std::string_view unit_of_measure, std::vector<std::string_view> const &columns) {
             m_unit_of_measure = std::string{unit_of_measure};
-            m_content = "description,elapsed_time,unit_of_measure\n";
+            out.write("description,");
+            for (auto const column : columns) {
+                out.write(column);
+                out.write(',');
+            }
+            out.write("unit_of_measure\n");
         }
-        [[nodiscard]] std::string process_data(pair_like auto const kv) const {
-            auto const elapsed_time = std::to_string(kv.second.count());
-            return kv.first + "," + elapsed_time + "," + m_unit_of_measure;
+        void write_record(auto &out, std::string const &key, auto const &value) const {
+            out.write(key);
+            out.write(',');
+            detail::write_value(out, value, {.separator = ",", .with_keys = false});
+            out.write(',');
+            out.write(m_unit_of_measure);
         }
-        void finish() { m_content += '\n'; }
+        static void finish(auto &out) { out.write('\n'); }
     };
 
     struct json : detail::base_formatter<json> {
@@ -319,25 +1140,25 @@ namespace formatters {
         [[nodiscard]] static std::string_view type() noexcept { return "json"; }
 
     private:
-        std::string m_content{};
-
         [[nodiscard]] static std::string_view separator() noexcept { return ",\n"; }
 
-        void start(std::string_view unit_of_measure) {
-            auto const times = []() {
-                auto const [local_time, utc_time] = detail::today();
-                std::string times_{};
-                if (local_time) { times_ += "\n    local_time: \"" + local_time.value() + "\","; }
-                if (utc_time) { times_ += "\n    utc_time: \"" + utc_time.value() + "\","; }
-                return times_;
-            }();
-            m_content = std::string{"{"} + times + "\n    time_unit: \"" + unit_of_measure.data() + "\",\n";
-        }
-        [[nodiscard]] static std::string process_data(pair_like auto const kv) {
-            auto const elapsed_time = std::to_string(kv.second.count());
-            return std::string{"    "} + kv.first + ": " + elapsed_time;
-        }
-        void finish() { m_content += "\n}\n"; }
+        static void start(auto &out, std::string_view unit_of_measure) {
+            auto const [local_time, utc_time] = detail::today();
+            out.write('{');
+            if (local_time) { out.write("\n    \"local_time\": \"" + local_time.value() + "\","); }
+            if (utc_time) { out.write("\n    \"utc_time\": \"" + utc_time.value() + "\","); }
+            out.write("\n    \"time_unit\": \"");
+            out.write(unit_of_measure);
+            out.write("\",\n    \"sections\": {\n");
+        }
+        // Records are members of "sections", so that their names never clash with the metadata
+        static void write_record(auto &out, std::string const &key, auto const &value) {
+            out.write("        \"");
+            out.write(detail::json_escape(key));
+            out.write("\": ");
+            detail::write_value(out, value, {.open = "{", .key_separator = ": ", .separator = ", ", .close = "}", .key_quote = "\"", .non_finite = "null"});
+        }
+        static void finish(auto &out) { out.write("\n    }\n}\n"); }
     };
 
     struct yaml : detail::base_formatter<yaml> {
@@ -345,25 +1166,22 @@ namespace formatters {
         [[nodiscard]] static std::string_view type() noexcept { return "yaml"; }
 
     private:
-        std::string m_content{};
-
         [[nodiscard]] static std::string_view separator() noexcept { return "\n"; }
 
-        void start(std::string_view unit_of_measure) {
-            auto const times = []() {
-                auto const [local_time, utc_time] = detail::today();
-                std::string times_{};
-                if (local_time) { times_ += "local_time: \"" + local_time.value() + "\"\n"; }
-                if (utc_time) { times_ += "utc_time: \"" + utc_time.value() + "\"\n"; }
-                return times_;
-            }();
-            m_content = times + "time_unit: \"" + unit_of_measure.data() + "\"\n";
-        }
-        [[nodiscard]] static std::string process_data(pair_like auto const kv) {
-            auto const elapsed_time = std::to_string(kv.second.count());
-            return kv.first + ": " + elapsed_time;
-        }
-        void finish() { m_content += "\n"; }
+        static void start(auto &out, std::string_view unit_of_measure) {
+            auto const [local_time, utc_time] = detail::today();
+            if (local_time) { out.write("local_time: \"" + local_time.value() + "\"\n"); }
+            if (utc_time) { out.write("utc_time: \"" + utc_time.value() + "\"\n"); }
+            out.write("time_unit: \"");
+            out.write(unit_of_measure);
+            out.write("\"\n");
+        }
+        static void write_record(auto &out, std::string const &key, auto const &value) {
+            out.write(key);
+            out.write(": ");
+            detail::write_value(out, value, {.open = "{", .key_separator = ": ", .separator = ", ", .close = "}"});
+        }
+        static void finish(auto &out) { out.write('\n'); }
     };
 
     struct markdown : detail::base_formatter<markdown> {
@@ -371,28 +1189,28 @@ namespace formatters {
         [[nodiscard]] static std::string_view type() noexcept { return "markdown"; }
 
     private:
-        std::string m_content{};
-
         [[nodiscard]] static std::string_view separator() noexcept { return "\n"; }
 
-        void start(std::string_view unit_of_measure) {
-            m_content = "# Benchmark Report\n\n";
-            auto const times = []() -> std::string {
-                auto const [local_time, utc_time] = detail::today();
-                if (!local_time && !utc_time) { return ""; }
-                std::string times_ = "## Date time\n\n";
-                if (local_time) { times_ += "- Local time: " + local_time.value() + "\n"; }
-                if (utc_time) { times_ += "- UTC time: " + utc_time.value() + "\n"; }
-                times_ += "\n";
-                return times_;
-            }();
-            m_content += times + "## Unit of measure\n\n-Unit: " + unit_of_measure.data() + "\n\n## Data\n\n";
-        }
-        [[nodiscard]] static std::string process_data(pair_like auto const kv) {
-            auto const elapsed_time = std::to_string(kv.second.count());
-            return std::string{"- *"} + kv.first + "*: " + elapsed_time;
-        }
-        void finish() { m_content += "\n"; }
+        static void start(auto &out, std::string_view unit_of_measure) {
+            out.write("# Benchmark Report\n\n");
+            auto const [local_time, utc_time] = detail::today();
+            if (local_time || utc_time) {
+                out.write("## Date time\n\n");
+                if (local_time) { out.write("- Local time: " + local_time.value() + "\n"); }
+                if (utc_time) { out.write("- UTC time: " + utc_time.value() + "\n"); }
+                out.write('\n');
+            }
+            out.write("## Unit of measure\n\n-Unit: ");
+            out.write(unit_of_measure);
+            out.write("\n\n## Data\n\n");
+        }
+        static void write_record(auto &out, std::string const &key, auto const &value) {
+            out.write("- *");
+            out.write(key);
+            out.write("*: ");
+            detail::write_value(out, value, {.key_separator = ": ", .separator = ", "});
+        }
+        static void finish(auto &out) { out.write('\n'); }
     };
 
     struct html : detail::base_formatter<html> {
@@ -400,10 +1218,8 @@ namespace formatters {
         [[nodiscard]] static std::string_view type() noexcept { return "html"; }
 
     private:
-        std::string m_content{};
-
-        void start(std::string_view unit_of_measure) {
-            m_content =
+        static void start(auto &out, std::string_view unit_of_measure) {
+            out.write(
                 "<!doctype html>\n"
                 "  <html>\n"
                 "    <head>\n"
@@ -412,36 +1228,44 @@ namespace formatters {
                 "      <meta name=\"Report of registerd timestamps\">\n"
                 "    </head>\n"
                 "    <body>\n"
-                "    <h1>Benchmark Report</h1>\n\n";
-            auto const times = []() -> std::string {
-                auto const [local_time, utc_time] = detail::today();
-                if (!local_time && !utc_time) { return ""; }
-                std::string times_ =
+                "    <h1>Benchmark Report</h1>\n\n");
+            auto const [local_time, utc_time] = detail::today();
+            if (local_time || utc_time) {
+                out.write(
                     "      <h2>Date and time</h2>\n\n"
-                    "      <ul>\n";
-
-                if (local_time) { times_ += "        <li>Local: " + local_time.value() + "</li>\n"; }
-                if (utc_time) { times_ += "        <li>Local: " + utc_time.value() + "</li>\n"; }
-                times_ += "      </ul>\n\n";
-                return times_;
-            }();
-            m_content += times + "      <h2>Unit of measure</h2>\n\n      " + unit_of_measure.data() + "\n\n";
-            m_content += "      <h2>Data</h2>\n\n      <ul>\n";
+                    "      <ul>\n");
+                if (local_time) { out.write("        <li>Local: " + local_time.value() + "</li>\n"); }
+                if (utc_time) { out.write("        <li>Local: " + utc_time.value() + "</li>\n"); }
+                out.write("      </ul>\n\n");
+            }
+            out.write("      <h2>Unit of measure</h2>\n\n      ");
+            out.write(unit_of_measure);
+            out.write("\n\n      <h2>Data</h2>\n\n      <ul>\n");
         }
 
-        [[nodiscard]] static std::string process_data(pair_like auto const kv) {
-            auto const elapsed_time = std::to_string(kv.second.count());
-            return std::string{"        <li>"} + kv.first + ": " + elapsed_time + "</li>";
+        static void write_record(auto &out, std::string const &key, auto const &value) {
+            out.write("        <li>");
+            out.write(key);
+            out.write(": ");
+            detail::write_value(out, value, {.key_separator = ": ", .separator = ", "});
+            out.write("</li>");
         }
 
         [[nodiscard]] static std::string_view separator() noexcept { return "\n"; }
 
-        void finish() {
-            m_content += "\n      </ul>\n\n    </body>\n  </html>\n\n";
+        static void finish(auto &out) {
+            out.write("\n      </ul>\n\n    </body>\n  </html>\n\n");
         }
     };
 }  // namespace formatters
 
+template <typename L, typename F, typename S = string_sink>
+concept streaming_formatter =
+    time_logger<L> && report_sink<S> && std::default_initializable<F>
+    && requires (L const &logger, F f, S sink) {
+           f.write(logger, sink, report_order::as_logged);
+       };
+
 template <typename... AdditionalFormatters>
 class reporter {
 public:
@@ -468,6 +1292,20 @@ public:
         return std::string{log_reporter.get_report()};
     }
 
+    // The report is written to the sink while the logger is visited, without building it in memory
+    template <typename Formatter, time_logger Logger, report_sink Sink>
+    requires streaming_formatter<Logger, Formatter, Sink>
+    static void write(Logger const &logger, Sink &sink, report_order order = report_order::as_logged) {
+        Formatter{}.write(logger, sink, order);
+    }
+
+    template <typename Formatter, time_logger Logger>
+    requires streaming_formatter<Logger, Formatter, ostream_sink>
+    static void write(Logger const &logger, std::ostream &out, report_order order = report_order::as_logged) {
+        ostream_sink sink{out};
+        write<Formatter>(logger, sink, order);
+    }
+
 private:
     std::variant<formatters::json,
                  formatters::csv,
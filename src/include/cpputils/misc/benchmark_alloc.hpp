@@ -0,0 +1,169 @@
+#ifndef CPPUTILS_BENCHMARK_ALLOC_HPP
+#define CPPUTILS_BENCHMARK_ALLOC_HPP
+
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cpputils::benchmark {
+
+namespace detail {
+    // Heap activity of a thread, updated by the operators of benchmark_alloc_hooks.hpp.
+    // Memory freed by a thread other than the one that allocated it makes live go down on the
+    // freeing thread, so live is signed.
+    struct alloc_stats {
+        std::uint64_t allocations{};
+        std::uint64_t bytes{};
+        std::int64_t live{};
+        std::int64_t peak{};
+    };
+
+    // Constant initialized: usable from operator new before any dynamic initialization
+    inline thread_local constinit alloc_stats thread_alloc_stats{};
+
+    inline constinit std::atomic<bool> alloc_hooks_installed{false};
+
+    inline void on_allocation(std::size_t size) noexcept {
+        auto &stats = thread_alloc_stats;
+        ++stats.allocations;
+        stats.bytes += size;
+        stats.live += static_cast<std::int64_t>(size);
+        stats.peak = std::max(stats.peak, stats.live);
+    }
+
+    inline void on_deallocation(std::size_t size) noexcept {
+        thread_alloc_stats.live -= static_cast<std::int64_t>(size);
+    }
+}  // namespace detail
+
+// Whether benchmark_alloc_hooks.hpp has been included in the program
+[[nodiscard]] inline bool allocation_tracking_enabled() noexcept {
+    return detail::alloc_hooks_installed.load(std::memory_order_relaxed);
+}
+
+// Elapsed time and heap activity of a single measure. peak_bytes is the highest amount of memory
+// allocated by the section and still live at some point, relative to the start of the section.
+template <duration D>
+struct alloc_measurement {
+    D elapsed{};
+    std::uint64_t allocations{};
+    std::uint64_t bytes{};
+    std::uint64_t peak_bytes{};
+    bool tracked{};
+};
+
+// Counts the heap allocations made by the calling thread around a section. The counts are only
+// available if the program includes benchmark_alloc_hooks.hpp in one translation unit. Counters
+// can be nested: the peak of the outer section includes the peaks of the inner ones.
+template <typename Clock = default_clock>
+class alloc_counter {
+public:
+    using clock_t = Clock;
+
+    void start() {
+        auto &stats = detail::thread_alloc_stats;
+        m_outer_peak = stats.peak;
+        stats.peak = stats.live;
+        m_start_stats = stats;
+        m_start = Clock::now();
+    }
+
+    void stop() {
+        m_stop = Clock::now();
+        auto &stats = detail::thread_alloc_stats;
+        m_stop_stats = stats;
+        stats.peak = std::max(m_outer_peak, stats.peak);
+    }
+
+    [[nodiscard]] duration auto delta() const {
+        return m_stop - m_start;
+    }
+
+    [[nodiscard]] alloc_measurement<typename Clock::duration> measurement() const {
+        return {
+            .elapsed = delta(),
+            .allocations = m_stop_stats.allocations - m_start_stats.allocations,
+            .bytes = m_stop_stats.bytes - m_start_stats.bytes,
+            .peak_bytes = static_cast<std::uint64_t>(std::max(m_stop_stats.peak - m_start_stats.live, std::int64_t{})),
+            .tracked = allocation_tracking_enabled(),
+        };
+    }
+
+private:
+    std::chrono::time_point<Clock> m_start{};
+    std::chrono::time_point<Clock> m_stop{};
+    detail::alloc_stats m_start_stats{};
+    detail::alloc_stats m_stop_stats{};
+    std::int64_t m_outer_peak{};
+};
+
+// Record of a section measured with alloc_counter: mean elapsed time, mean allocations and bytes
+// allocated per measure and the highest peak of live bytes. Reported as nan if allocations were
+// never tracked.
+template <duration D = default_duration>
+class alloc_record : public detail::mean_record<D> {
+    using base_t = detail::mean_record<D>;
+
+public:
+    using base_t::record;
+
+    template <duration E>
+    void record(alloc_measurement<E> const &measurement) {
+        record(std::chrono::duration_cast<D>(measurement.elapsed));
+        if (!measurement.tracked) { return; }
+        ++m_tracked;
+        m_allocations += measurement.allocations;
+        m_bytes += measurement.bytes;
+        m_peak_bytes = std::max(m_peak_bytes, measurement.peak_bytes);
+    }
+
+    void merge(alloc_record const &other) {
+        base_t::merge(other);
+        m_tracked += other.m_tracked;
+        m_allocations += other.m_allocations;
+        m_bytes += other.m_bytes;
+        m_peak_bytes = std::max(m_peak_bytes, other.m_peak_bytes);
+    }
+
+    [[nodiscard]] double allocations() const { return per_measure(m_allocations); }
+
+    [[nodiscard]] double bytes() const { return per_measure(m_bytes); }
+
+    [[nodiscard]] double peak_bytes() const {
+        if (m_tracked == 0U) { return std::numeric_limits<double>::quiet_NaN(); }
+        return static_cast<double>(m_peak_bytes);
+    }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"samples"}, this->count());
+        f(std::string_view{"elapsed"}, this->elapsed());
+        f(std::string_view{"allocations"}, allocations());
+        f(std::string_view{"bytes"}, bytes());
+        f(std::string_view{"peak_bytes"}, peak_bytes());
+    }
+
+private:
+    std::uint64_t m_tracked{};
+    std::uint64_t m_allocations{};
+    std::uint64_t m_bytes{};
+    std::uint64_t m_peak_bytes{};
+
+    [[nodiscard]] double per_measure(std::uint64_t total) const {
+        if (m_tracked == 0U) { return std::numeric_limits<double>::quiet_NaN(); }
+        return static_cast<double>(total) / static_cast<double>(m_tracked);
+    }
+};
+
+template <duration D = default_duration>
+using alloc_logger = std::unordered_map<std::string, alloc_record<D>>;
+}  // namespace cpputils::benchmark
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef CPPUTILS_BENCHMARK_ALLOC_HOOKS_HPP
+#define CPPUTILS_BENCHMARK_ALLOC_HOOKS_HPP
+
+// Replaces the global allocation and deallocation functions to feed alloc_counter.
+// Include this header in exactly one translation unit of the program.
+
+#include "benchmark_alloc.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace cpputils::benchmark::detail {
+    // Stored right before every block: the pointer returned by malloc and the requested size
+    struct alloc_header {
+        void *base;
+        std::size_t size;
+    };
+
+    [[nodiscard]] inline alloc_header header_of(void *ptr) noexcept {
+        alloc_header header{};
+        std::memcpy(&header, static_cast<std::byte *>(ptr) - sizeof(alloc_header), sizeof(alloc_header));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return header;
+    }
+
+    [[nodiscard]] inline void *tracked_allocate(std::size_t size, std::size_t alignment) noexcept {
+        alignment = std::max(alignment, std::size_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__});
+        if (size > std::numeric_limits<std::size_t>::max() - sizeof(alloc_header) - alignment) { return nullptr; }
+        void *base = std::malloc(size + sizeof(alloc_header) + alignment);  // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+        if (base == nullptr) { return nullptr; }
+        auto const first = reinterpret_cast<std::uintptr_t>(base) + sizeof(alloc_header);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto const aligned = (first + alignment - 1U) & ~(std::uintptr_t{alignment} - 1U);
+        auto *ptr = static_cast<std::byte *>(base) + (aligned - reinterpret_cast<std::uintptr_t>(base));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        alloc_header const header{.base = base, .size = size};
+        std::memcpy(ptr - sizeof(alloc_header), &header, sizeof(alloc_header));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        on_allocation(size);
+        return ptr;
+    }
+
+    // Calls the new handler until the allocation succeeds, as the default operator new does
+    [[nodiscard]] inline void *tracked_allocate_or_throw(std::size_t size, std::size_t alignment) {
+        while (true) {
+            if (auto *ptr = tracked_allocate(size, alignment); ptr != nullptr) { return ptr; }
+            auto const handler = std::get_new_handler();
+            if (handler == nullptr) { throw std::bad_alloc{}; }
+            handler();
+        }
+    }
+
+    inline void tracked_deallocate(void *ptr) noexcept {
+        if (ptr == nullptr) { return; }
+        auto const header = header_of(ptr);
+        on_deallocation(header.size);
+        std::free(header.base);  // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+    }
+
+    // Static initialization of the including translation unit
+    [[maybe_unused]] inline bool const alloc_hooks_registered = [] {
+        alloc_hooks_installed.store(true, std::memory_order_relaxed);
+        return true;
+    }();
+}  // namespace cpputils::benchmark::detail
+
+// NOLINTBEGIN(cert-dcl54-cpp, hicpp-new-delete-operators, misc-new-delete-overloads)
+void *operator new(std::size_t size) {
+    return cpputils::benchmark::detail::tracked_allocate_or_throw(size, 0U);
+}
+
+void *operator new[](std::size_t size) {
+    return cpputils::benchmark::detail::tracked_allocate_or_throw(size, 0U);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return cpputils::benchmark::detail::tracked_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return cpputils::benchmark::detail::tracked_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t size, std::nothrow_t const &) noexcept {
+    return cpputils::benchmark::detail::tracked_allocate(size, 0U);
+}
+
+void *operator new[](std::size_t size, std::nothrow_t const &) noexcept {
+    return cpputils::benchmark::detail::tracked_allocate(size, 0U);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept {
+    return cpputils::benchmark::detail::tracked_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept {
+    return cpputils::benchmark::detail::tracked_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete(void *ptr, std::nothrow_t const &) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t, std::nothrow_t const &) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+void operator delete[](void *ptr, std::align_val_t, std::nothrow_t const &) noexcept { cpputils::benchmark::detail::tracked_deallocate(ptr); }
+// NOLINTEND(cert-dcl54-cpp, hicpp-new-delete-operators, misc-new-delete-overloads)
+
+#endif
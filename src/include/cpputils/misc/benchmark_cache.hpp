@@ -0,0 +1,100 @@
+#ifndef CPPUTILS_BENCHMARK_CACHE_HPP
+#define CPPUTILS_BENCHMARK_CACHE_HPP
+
+#include "benchmark.hpp"
+#include "system_macros.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#ifdef CPPUTILS_POSIX_PLATFORM
+#include <unistd.h>
+#endif
+
+namespace cpputils::benchmark {
+
+// How the caches are prepared before each measure
+enum class cache_mode : std::uint8_t {
+    // Nothing is done, results are not labelled
+    unlabelled,
+    // The working set is touched right before each measure
+    warm,
+    // The caches are flushed before each measure
+    cold,
+};
+
+[[nodiscard]] inline std::string_view to_string(cache_mode mode) noexcept {
+    switch (mode) {
+    case cache_mode::unlabelled: return "";
+    case cache_mode::warm: return "warm";
+    case cache_mode::cold: return "cold";
+    }
+    return "";
+}
+
+inline constexpr std::size_t cache_line_bytes = 64;
+
+// Size of the largest cache, or 32 MiB if it cannot be detected
+[[nodiscard]] inline std::size_t last_level_cache_size() {
+    constexpr std::size_t fallback = std::size_t{32} << 20U;
+#if defined(CPPUTILS_POSIX_PLATFORM) && defined(_SC_LEVEL3_CACHE_SIZE)
+    for (auto const name : {_SC_LEVEL4_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+        if (auto const size = sysconf(name); size > 0) { return static_cast<std::size_t>(size); }
+    }
+#endif
+    return fallback;
+}
+
+// Reads every cache line of the bytes, loading them in the caches
+inline void touch(std::span<std::byte const> bytes) noexcept {
+    std::byte sum{};
+    for (std::size_t i = 0; i < bytes.size(); i += cache_line_bytes) {
+        sum ^= bytes[i];
+    }
+    if (!bytes.empty()) { sum ^= bytes.back(); }
+    do_not_optimize(sum);
+}
+
+// Flushes the caches by streaming through a buffer larger than the last level cache
+class cache_evictor {
+public:
+    // 0 means twice the size of the last level cache
+    explicit cache_evictor(std::size_t bytes = 0U)
+        : m_size{bytes == 0U ? 2U * last_level_cache_size() : bytes}
+        , m_buffer{std::make_unique<std::byte[]>(m_size)} {}  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+    // Every line is written, so that it is owned by this core in all the cache levels
+    void evict() noexcept {
+        auto const buffer = std::span{m_buffer.get(), m_size};
+        for (std::size_t i = 0; i < buffer.size(); i += cache_line_bytes) {
+            buffer[i] = static_cast<std::byte>(static_cast<unsigned>(buffer[i]) + 1U);
+        }
+        clobber_memory();
+    }
+
+private:
+    std::size_t m_size;
+    std::unique_ptr<std::byte[]> m_buffer;  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+};
+
+namespace detail {
+    // Contiguous ranges are touched through their elements, anything else through its object
+    // representation
+    template <typename T>
+    void touch_object(T const &value) noexcept {
+        if constexpr (std::ranges::contiguous_range<T const> && std::ranges::sized_range<T const>) {
+            touch(std::as_bytes(std::span{std::ranges::data(value), std::ranges::size(value)}));
+        } else {
+            touch(std::as_bytes(std::span{std::addressof(value), 1U}));
+        }
+    }
+}  // namespace detail
+}  // namespace cpputils::benchmark
+
+#endif
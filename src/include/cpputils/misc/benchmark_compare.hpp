@@ -0,0 +1,598 @@
+#ifndef CPPUTILS_BENCHMARK_COMPARE_HPP
+#define CPPUTILS_BENCHMARK_COMPARE_HPP
+
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace cpputils::benchmark {
+
+inline constexpr std::string_view results_schema = "cpputils.benchmark.results";
+inline constexpr int results_schema_version = 1;
+
+// A section of a stored run. Times are counts of run_results::time_unit, nan if not available.
+struct section_result {
+    std::string name{};
+    double elapsed{};
+    std::vector<std::pair<std::string, double>> fields{};
+    // Every sample, if the record kept them (e.g. sample_set)
+    std::vector<double> samples{};
+};
+
+struct run_results {
+    std::string time_unit{};
+    std::vector<section_result> sections{};
+
+    [[nodiscard]] section_result const *find(std::string_view name) const {
+        auto const it = std::ranges::find(sections, name, &section_result::name);
+        return it == sections.cend() ? nullptr : &*it;
+    }
+};
+
+namespace detail {
+    [[nodiscard]] inline double count_of(auto const &value) {
+        if constexpr (duration<std::remove_cvref_t<decltype(value)>>) {
+            return static_cast<double>(value.count());
+        } else {
+            return static_cast<double>(value);
+        }
+    }
+
+    template <typename T>
+    concept with_samples =
+        requires (T const record) {
+            { record.samples() } -> std::ranges::input_range;
+        };
+
+    template <typename T>
+    concept with_base =
+        requires (T const record) {
+            record.base();
+        };
+
+    // Wrappers of a record (e.g. with_throughput) keep the samples of the record they wrap
+    template <typename T>
+    void append_samples(T const &record, std::vector<double> &samples) {
+        if constexpr (with_samples<T>) {
+            for (auto const &sample : record.samples()) {
+                samples.push_back(count_of(sample));
+            }
+        } else if constexpr (with_base<T>) {
+            append_samples(record.base(), samples);
+        }
+    }
+
+    template <loggable T>
+    [[nodiscard]] section_result result_of(std::string const &name, T const &value) {
+        section_result result{.name = name, .elapsed = count_of(elapsed_of(value))};
+        if constexpr (time_record<T>) {
+            for_each_reported_field(value, [&result](std::string_view field, auto const &field_value) {
+                result.fields.emplace_back(std::string{field}, count_of(field_value));
+            });
+            append_samples(value, result.samples);
+        } else {
+            result.fields.emplace_back("elapsed_time", result.elapsed);
+            result.samples.push_back(result.elapsed);
+        }
+        return result;
+    }
+
+    // Reads the subset of JSON produced by formatters::json_results. Every function returns false
+    // (or nullopt) on malformed input.
+    class json_reader {
+    public:
+        explicit json_reader(std::string_view text)
+            : m_text{text} {}
+
+        [[nodiscard]] bool at_end() {
+            skip_spaces();
+            return m_position == m_text.size();
+        }
+
+        [[nodiscard]] bool consume(char c) {
+            skip_spaces();
+            if (m_position < m_text.size() && m_text[m_position] == c) {
+                ++m_position;
+                return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] std::optional<std::string> string() {
+            if (!consume('"')) { return std::nullopt; }
+            std::string result{};
+            while (m_position < m_text.size()) {
+                auto const c = m_text[m_position++];
+                if (c == '"') { return result; }
+                if (c != '\\') {
+                    result += c;
+                    continue;
+                }
+                if (m_position == m_text.size()) { return std::nullopt; }
+                switch (m_text[m_position++]) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': {
+                    auto const code_point = hex_code_point();
+                    if (!code_point) { return std::nullopt; }
+                    append_utf8(result, *code_point);
+                    break;
+                }
+                default: return std::nullopt;
+                }
+            }
+            return std::nullopt;
+        }
+
+        // null is read as nan, other non-finite values are not JSON
+        [[nodiscard]] std::optional<double> number() {
+            skip_spaces();
+            if (m_text.substr(m_position).starts_with("null")) {
+                m_position += 4U;  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            double value{};
+            auto const *const first = std::next(m_text.data(), static_cast<std::ptrdiff_t>(m_position));
+            auto const *const last = std::next(m_text.data(), static_cast<std::ptrdiff_t>(m_text.size()));
+            auto const [end, error] = std::from_chars(first, last, value);
+            if (error != std::errc{} || !std::isfinite(value)) { return std::nullopt; }
+            m_position += static_cast<std::size_t>(end - first);
+            return value;
+        }
+
+        // f(key) is called for every member and must read its value
+        [[nodiscard]] bool object(auto &&f) {
+            if (!consume('{')) { return false; }
+            if (consume('}')) { return true; }
+            do {
+                auto const key = string();
+                if (!key || !consume(':') || !f(*key)) { return false; }
+            } while (consume(','));
+            return consume('}');
+        }
+
+        // f() is called for every element and must read it
+        [[nodiscard]] bool array(auto &&f) {
+            if (!consume('[')) { return false; }
+            if (consume(']')) { return true; }
+            do {
+                if (!f()) { return false; }
+            } while (consume(','));
+            return consume(']');
+        }
+
+        // Values of unknown members are skipped, so that readers accept newer minor versions
+        [[nodiscard]] bool skip() {
+            skip_spaces();
+            if (m_position == m_text.size()) { return false; }
+            switch (m_text[m_position]) {
+            case '{': return object([this](std::string const &) { return skip(); });
+            case '[': return array([this] { return skip(); });
+            case '"': return string().has_value();
+            case 't': return literal("true");
+            case 'f': return literal("false");
+            default: return number().has_value();
+            }
+        }
+
+    private:
+        std::string_view m_text;
+        std::size_t m_position{};
+
+        void skip_spaces() {
+            while (m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\n' || m_text[m_position] == '\r' || m_text[m_position] == '\t')) {
+                ++m_position;
+            }
+        }
+
+        [[nodiscard]] bool literal(std::string_view word) {
+            if (!m_text.substr(m_position).starts_with(word)) { return false; }
+            m_position += word.size();
+            return true;
+        }
+
+        [[nodiscard]] std::optional<std::uint32_t> hex_code_point() {
+            constexpr std::size_t digits = 4;
+            if (m_text.size() - m_position < digits) { return std::nullopt; }
+            std::uint32_t code_point{};
+            auto const *const first = std::next(m_text.data(), static_cast<std::ptrdiff_t>(m_position));
+            auto const [end, error] = std::from_chars(first, std::next(first, digits), code_point, 16);  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+            if (error != std::errc{} || end != std::next(first, digits)) { return std::nullopt; }
+            m_position += digits;
+            constexpr std::uint32_t high_surrogate = 0xD800U;
+            constexpr std::uint32_t low_surrogate = 0xDC00U;
+            constexpr std::uint32_t surrogate_end = 0xE000U;
+            if (code_point >= high_surrogate && code_point < low_surrogate && m_text.substr(m_position).starts_with("\\u")) {
+                m_position += 2U;
+                auto const low = hex_code_point();
+                if (!low || *low < low_surrogate || *low >= surrogate_end) { return std::nullopt; }
+                return 0x10000U + ((code_point - high_surrogate) << 10U) + (*low - low_surrogate);  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+            }
+            return code_point;
+        }
+
+        // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        static void append_utf8(std::string &out, std::uint32_t code_point) {
+            if (code_point < 0x80U) {
+                out += static_cast<char>(code_point);
+            } else if (code_point < 0x800U) {
+                out += static_cast<char>(0xC0U | (code_point >> 6U));
+                out += static_cast<char>(0x80U | (code_point & 0x3FU));
+            } else if (code_point < 0x10000U) {
+                out += static_cast<char>(0xE0U | (code_point >> 12U));
+                out += static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU));
+                out += static_cast<char>(0x80U | (code_point & 0x3FU));
+            } else {
+                out += static_cast<char>(0xF0U | (code_point >> 18U));
+                out += static_cast<char>(0x80U | ((code_point >> 12U) & 0x3FU));
+                out += static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU));
+                out += static_cast<char>(0x80U | (code_point & 0x3FU));
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    };
+
+    [[nodiscard]] inline bool read_section(json_reader &reader, section_result &section) {
+        return reader.object([&](std::string const &key) {
+            if (key == "name") {
+                auto name = reader.string();
+                if (name) { section.name = std::move(*name); }
+                return name.has_value();
+            }
+            if (key == "elapsed") {
+                auto const elapsed = reader.number();
+                section.elapsed = elapsed.value_or(0.0);
+                return elapsed.has_value();
+            }
+            if (key == "fields") {
+                return reader.object([&](std::string const &field) {
+                    auto const value = reader.number();
+                    if (value) { section.fields.emplace_back(field, *value); }
+                    return value.has_value();
+                });
+            }
+            if (key == "samples") {
+                return reader.array([&] {
+                    auto const value = reader.number();
+                    if (value) { section.samples.push_back(*value); }
+                    return value.has_value();
+                });
+            }
+            return reader.skip();
+        });
+    }
+}  // namespace detail
+
+// The results of a logger, with the sections sorted by name
+template <time_logger Logger>
+[[nodiscard]] run_results collect_results(Logger const &logger) {
+    using mapped_type = typename Logger::mapped_type;
+    run_results results{.time_unit = std::string{detail::detect_time_unit<detail::logged_duration_t<mapped_type>>()}};
+    detail::for_each_entry(logger, report_order::as_logged, [&results](std::string const &key, mapped_type const &value) {
+        results.sections.push_back(detail::result_of(key, value));
+    });
+    std::ranges::sort(results.sections, {}, &section_result::name);
+    return results;
+}
+
+// Reads a report written by formatters::json_results. Returns nullopt if the text is malformed,
+// has a different schema or a newer major version.
+[[nodiscard]] inline std::optional<run_results> parse_results(std::string_view json) {
+    detail::json_reader reader{json};
+    run_results results{};
+    bool schema_found{false};
+    bool const parsed = reader.object([&](std::string const &key) {
+        if (key == "schema") {
+            auto const schema = reader.string();
+            schema_found = schema == results_schema;
+            return schema_found;
+        }
+        if (key == "version") {
+            auto const version = reader.number();
+            return version && *version >= 1.0 && *version < results_schema_version + 1.0;
+        }
+        if (key == "time_unit") {
+            auto unit = reader.string();
+            if (unit) { results.time_unit = std::move(*unit); }
+            return unit.has_value();
+        }
+        if (key == "sections") {
+            return reader.array([&] { return detail::read_section(reader, results.sections.emplace_back()); });
+        }
+        return reader.skip();
+    });
+    if (!parsed || !schema_found || !reader.at_end()) { return std::nullopt; }
+    return results;
+}
+
+namespace formatters {
+    // Machine-readable report with a stable schema, to be stored and compared with compare():
+    // {"schema": "cpputils.benchmark.results", "version": 1, "time_unit": ..., "sections": [
+    //   {"name": ..., "elapsed": ..., "fields": {...}, "samples": [...]}, ...]}
+    // Members may be added in later versions of the same major version.
+    struct json_results : detail::string_report<json_results> {
+        [[nodiscard]] static std::string_view type() noexcept { return "json_results"; }
+
+        template <time_logger Logger, report_sink Sink>
+        static void write(Logger const &logger, Sink &sink, report_order order) {
+            using mapped_type = typename Logger::mapped_type;
+            report_writer out{sink};
+            out.write("{\"schema\": \"");
+            out.write(results_schema);
+            out.write("\", \"version\": ");
+            out.write_number(results_schema_version);
+            out.write(", \"time_unit\": \"");
+            out.write(detail::detect_time_unit<detail::logged_duration_t<mapped_type>>());
+            out.write("\", \"sections\": [");
+            bool first{true};
+            detail::for_each_entry(logger, order, [&](std::string const &key, mapped_type const &value) {
+                out.write(first ? "\n" : ",\n");
+                first = false;
+                write_section(out, detail::result_of(key, value));
+            });
+            out.write("\n]}\n");
+        }
+
+    private:
+        static void write_section(auto &out, section_result const &section) {
+            constexpr detail::record_layout layout{.non_finite = "null"};
+            out.write("  {\"name\": \"");
+            out.write(detail::json_escape(section.name));
+            out.write("\", \"elapsed\": ");
+            detail::write_field(out, section.elapsed, layout);
+            out.write(", \"fields\": {");
+            for (std::size_t i = 0; i < section.fields.size(); ++i) {
+                out.write(i == 0U ? "\"" : ", \"");
+                out.write(detail::json_escape(section.fields[i].first));
+                out.write("\": ");
+                detail::write_field(out, section.fields[i].second, layout);
+            }
+            out.write("}, \"samples\": [");
+            for (std::size_t i = 0; i < section.samples.size(); ++i) {
+                if (i > 0U) { out.write(", "); }
+                detail::write_field(out, section.samples[i], layout);
+            }
+            out.write("]}");
+        }
+    };
+}  // namespace formatters
+
+enum class verdict : std::uint8_t {
+    unchanged,
+    improved,
+    regressed,
+};
+
+[[nodiscard]] inline std::string_view to_string(verdict v) noexcept {
+    switch (v) {
+    case verdict::unchanged: return "unchanged";
+    case verdict::improved: return "improved";
+    case verdict::regressed: return "regressed";
+    }
+    return "";
+}
+
+struct comparison_options {
+    // Relative change of the median below which a section is unchanged
+    double threshold{0.05};
+    // Of the bootstrap interval, and 1 - significance level of the Mann-Whitney test
+    double confidence{0.95};
+    std::size_t resamples{1'000};
+    // The bootstrap is seeded, so that comparing the same runs always gives the same result
+    std::uint64_t seed{0x5EED};
+};
+
+// Times are in the unit of the baseline. ci_low/ci_high bound relative_delta; they and p_value
+// are nan when a run has fewer than two samples of the section, and the verdict then depends
+// only on the threshold.
+struct section_comparison {
+    std::string name{};
+    double baseline{};
+    double candidate{};
+    // candidate / baseline - 1: positive when the candidate is slower
+    double relative_delta{};
+    double ci_low{};
+    double ci_high{};
+    double p_value{};
+    verdict result{verdict::unchanged};
+};
+
+struct comparison {
+    std::string time_unit{};
+    std::vector<section_comparison> sections{};
+    std::vector<std::string> only_in_baseline{};
+    std::vector<std::string> only_in_candidate{};
+
+    [[nodiscard]] bool has_regressions() const {
+        return std::ranges::any_of(sections, [](auto const &s) { return s.result == verdict::regressed; });
+    }
+};
+
+namespace detail {
+    [[nodiscard]] inline std::optional<double> seconds_per_unit(std::string_view unit) {
+        constexpr std::array<std::pair<std::string_view, double>, 7> units{{
+            {"nanoseconds", 1e-9},
+            {"microseconds", 1e-6},
+            {"milliseconds", 1e-3},
+            {"seconds", 1.0},
+            {"minutes", 60.0},
+            {"hours", 3'600.0},
+            {"days", 86'400.0},
+        }};
+        auto const it = std::ranges::find(units, unit, &std::pair<std::string_view, double>::first);
+        if (it == units.cend()) { return std::nullopt; }
+        return it->second;
+    }
+
+    // Mean of the two middle values for an even count
+    [[nodiscard]] inline double median_of(std::vector<double> values) {
+        if (values.empty()) { return std::numeric_limits<double>::quiet_NaN(); }
+        auto const middle = std::next(values.begin(), static_cast<std::ptrdiff_t>(values.size() / 2U));
+        std::ranges::nth_element(values, middle);
+        if (values.size() % 2U == 1U) { return *middle; }
+        return (*middle + *std::ranges::max_element(values.begin(), middle)) / 2.0;
+    }
+
+    // Two-sided p-value of the Mann-Whitney U test, normal approximation with tie correction
+    [[nodiscard]] inline double mann_whitney_p_value(std::vector<double> const &lhs, std::vector<double> const &rhs) {
+        std::vector<std::pair<double, bool>> all{};
+        all.reserve(lhs.size() + rhs.size());
+        for (auto const v : lhs) { all.emplace_back(v, true); }
+        for (auto const v : rhs) { all.emplace_back(v, false); }
+        std::ranges::sort(all, {}, &std::pair<double, bool>::first);
+
+        double lhs_rank_sum{};
+        double ties{};
+        for (std::size_t i = 0; i < all.size();) {
+            auto j = i;
+            // Ties are exact repetitions of the same value
+            while (j < all.size() && !(all[i].first < all[j].first)) { ++j; }
+            auto const rank = static_cast<double>(i + j + 1U) / 2.0;
+            auto const count = static_cast<double>(j - i);
+            ties += count * count * count - count;
+            for (auto k = i; k < j; ++k) {
+                if (all[k].second) { lhs_rank_sum += rank; }
+            }
+            i = j;
+        }
+        auto const n1 = static_cast<double>(lhs.size());
+        auto const n2 = static_cast<double>(rhs.size());
+        auto const n = n1 + n2;
+        auto const u = lhs_rank_sum - n1 * (n1 + 1.0) / 2.0;
+        auto const mean = n1 * n2 / 2.0;
+        auto const variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        if (variance <= 0.0) { return 1.0; }
+        auto const z = std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+        return std::erfc(z / std::numbers::sqrt2);
+    }
+
+    // Percentile bootstrap interval of candidate median / baseline median - 1
+    [[nodiscard]] inline std::pair<double, double> bootstrap_interval(std::vector<double> const &baseline,
+                                                                      std::vector<double> const &candidate,
+                                                                      comparison_options const &options) {
+        std::mt19937_64 engine{options.seed};
+        auto const resample_median = [&engine](std::vector<double> const &values, std::vector<double> &buffer) {
+            std::uniform_int_distribution<std::size_t> pick{0, values.size() - 1U};
+            buffer.resize(values.size());
+            std::ranges::generate(buffer, [&] { return values[pick(engine)]; });
+            return median_of(buffer);
+        };
+        std::vector<double> deltas{};
+        deltas.reserve(options.resamples);
+        std::vector<double> buffer{};
+        for (std::size_t i = 0; i < options.resamples; ++i) {
+            auto const base = resample_median(baseline, buffer);
+            auto const cand = resample_median(candidate, buffer);
+            if (base > 0.0) { deltas.push_back(cand / base - 1.0); }
+        }
+        if (deltas.empty()) { return {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()}; }
+        std::ranges::sort(deltas);
+        auto const tail = (1.0 - options.confidence) / 2.0;
+        auto const at = [&deltas](double q) {
+            auto const last = static_cast<double>(deltas.size() - 1U);
+            return deltas[static_cast<std::size_t>(std::round(std::clamp(q, 0.0, 1.0) * last))];
+        };
+        return {at(tail), at(1.0 - tail)};
+    }
+
+    [[nodiscard]] inline section_comparison compare_section(section_result const &baseline,
+                                                            section_result const &candidate,
+                                                            double candidate_scale,
+                                                            comparison_options const &options) {
+        auto candidate_samples = candidate.samples;
+        for (auto &sample : candidate_samples) { sample *= candidate_scale; }
+        auto const nan = std::numeric_limits<double>::quiet_NaN();
+        section_comparison result{.name = baseline.name, .ci_low = nan, .ci_high = nan, .p_value = nan};
+        result.baseline = baseline.samples.empty() ? baseline.elapsed : median_of(baseline.samples);
+        result.candidate = candidate_samples.empty() ? candidate.elapsed * candidate_scale : median_of(candidate_samples);
+        result.relative_delta = result.baseline > 0.0 ? result.candidate / result.baseline - 1.0 : nan;
+
+        bool significant{true};
+        if (baseline.samples.size() >= 2U && candidate_samples.size() >= 2U) {
+            result.p_value = mann_whitney_p_value(baseline.samples, candidate_samples);
+            std::tie(result.ci_low, result.ci_high) = bootstrap_interval(baseline.samples, candidate_samples, options);
+            significant = result.p_value < 1.0 - options.confidence;
+        }
+        if (significant && result.relative_delta > options.threshold) {
+            result.result = verdict::regressed;
+        } else if (significant && result.relative_delta < -options.threshold) {
+            result.result = verdict::improved;
+        }
+        return result;
+    }
+}  // namespace detail
+
+// Matches the sections of two runs by name. A section is regressed (improved) if its median grew
+// (shrank) by more than the threshold and the samples of the two runs differ significantly.
+[[nodiscard]] inline comparison compare(run_results const &baseline, run_results const &candidate, comparison_options const &options = {}) {
+    comparison result{.time_unit = baseline.time_unit};
+    auto const baseline_unit = detail::seconds_per_unit(baseline.time_unit);
+    auto const candidate_unit = detail::seconds_per_unit(candidate.time_unit);
+    auto const scale = baseline_unit && candidate_unit ? *candidate_unit / *baseline_unit : 1.0;
+    for (auto const &section : baseline.sections) {
+        if (auto const *const other = candidate.find(section.name); other != nullptr) {
+            result.sections.push_back(detail::compare_section(section, *other, scale, options));
+        } else {
+            result.only_in_baseline.push_back(section.name);
+        }
+    }
+    for (auto const &section : candidate.sections) {
+        if (baseline.find(section.name) == nullptr) { result.only_in_candidate.push_back(section.name); }
+    }
+    return result;
+}
+
+// One csv line per section; sections found in a single run have the verdict "removed" or "added"
+template <report_sink Sink>
+void write_comparison(comparison const &result, Sink &sink) {
+    report_writer out{sink};
+    constexpr detail::record_layout layout{};
+    out.write("section,baseline,candidate,relative_delta,ci_low,ci_high,p_value,verdict,unit_of_measure\n");
+    for (auto const &section : result.sections) {
+        out.write(section.name);
+        for (auto const value : {section.baseline, section.candidate, section.relative_delta, section.ci_low, section.ci_high, section.p_value}) {
+            out.write(',');
+            detail::write_field(out, value, layout);
+        }
+        out.write(',');
+        out.write(to_string(section.result));
+        out.write(',');
+        out.write(result.time_unit);
+        out.write('\n');
+    }
+    for (auto const &name : result.only_in_baseline) {
+        out.write(name);
+        out.write(",,,,,,,removed,");
+        out.write(result.time_unit);
+        out.write('\n');
+    }
+    for (auto const &name : result.only_in_candidate) {
+        out.write(name);
+        out.write(",,,,,,,added,");
+        out.write(result.time_unit);
+        out.write('\n');
+    }
+}
+}  // namespace cpputils::benchmark
+
+#endif
@@ -0,0 +1,414 @@
+#ifndef CPPUTILS_BENCHMARK_CONCURRENT_HPP
+#define CPPUTILS_BENCHMARK_CONCURRENT_HPP
+
+#include "benchmark.hpp"
+#include "system_macros.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef CPPUTILS_LINUX_PLATFORM
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cpputils::benchmark {
+
+namespace detail {
+    inline constexpr std::size_t cache_line_size = 64;
+
+    template <typename T>
+    concept mergeable_record =
+        time_record<T>
+        && requires (T lhs, T const rhs) {
+               lhs.merge(rhs);
+           };
+
+    // Only the owning thread writes to a buffer: the flag is contended only while a report is merged
+    template <typename T>
+    struct alignas(cache_line_size) thread_buffer {
+        std::atomic_flag busy{};
+        std::size_t index{};
+        T value{};
+
+        void lock() noexcept {
+            while (busy.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        void unlock() noexcept {
+            busy.clear(std::memory_order_release);
+        }
+    };
+
+#ifdef CPPUTILS_LINUX_PLATFORM
+    [[nodiscard]] inline bool register_heavy_fence() noexcept {
+        return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0U, 0) == 0;  // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+    }
+#else
+    [[nodiscard]] inline bool register_heavy_fence() noexcept { return false; }
+#endif
+
+    // Asymmetric fences: the heavy fence makes every thread of the process execute a full fence
+    // (membarrier on Linux), so that the light one only has to keep the compiler from reordering.
+    // Without a heavy fence both are full fences.
+    [[nodiscard]] inline bool heavy_fence_available() noexcept {
+        static bool const available = register_heavy_fence();
+        return available;
+    }
+
+    inline void light_fence() noexcept {
+        if (heavy_fence_available()) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    inline void heavy_fence() noexcept {
+#ifdef CPPUTILS_LINUX_PLATFORM
+        if (heavy_fence_available()) {
+            syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0U, 0);  // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+            return;
+        }
+#endif
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // Publishes the end of a write, even if it threw
+    class sequence_guard {
+    public:
+        sequence_guard(std::atomic<std::uint64_t> &sequence, std::uint64_t end) noexcept
+            : m_sequence{&sequence}
+            , m_end{end} {}
+
+        sequence_guard(sequence_guard const &) = delete;
+        sequence_guard(sequence_guard &&) = delete;
+        sequence_guard &operator=(sequence_guard const &) = delete;
+        sequence_guard &operator=(sequence_guard &&) = delete;
+
+        ~sequence_guard() { m_sequence->store(m_end, std::memory_order_release); }
+
+    private:
+        std::atomic<std::uint64_t> *m_sequence;
+        std::uint64_t m_end;
+    };
+
+    // Two halves of T: the owning thread writes into the current one without locking, a reader
+    // switches the owner to the other half and takes the retired one once a write in progress ended.
+    // The owner never waits, readers must be serialized.
+    template <typename T>
+    struct alignas(cache_line_size) double_buffer {
+        std::size_t index{};
+        // Odd while the owner writes
+        std::atomic<std::uint64_t> sequence{};
+        std::atomic<std::size_t> current{};
+        std::array<T, 2> halves{};
+
+        // f(half, index of the half), called by the owning thread only
+        decltype(auto) write(auto &&f) {
+            auto const start = sequence.load(std::memory_order_relaxed);
+            sequence.store(start + 1U, std::memory_order_relaxed);
+            light_fence();
+            sequence_guard const guard{sequence, start + 2U};
+            auto const half = current.load(std::memory_order_acquire);
+            return f(halves[half], half);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+
+        // Moves the owner to the other half, returns the retired one. take() it after a heavy fence.
+        [[nodiscard]] std::size_t switch_half() noexcept {
+            auto const retired = current.load(std::memory_order_relaxed);
+            current.store(retired ^ 1U, std::memory_order_release);
+            return retired;
+        }
+
+        // f(retired half), once the write the owner may have started before the switch ended
+        void take(std::size_t retired, auto &&f) {
+            auto const observed = sequence.load(std::memory_order_acquire);
+            if (observed % 2U == 1U) {
+                while (sequence.load(std::memory_order_acquire) == observed) {
+                    std::this_thread::yield();
+                }
+            }
+            f(halves[retired]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    };
+
+    // A buffer for every thread that used it. Buffers are never moved or destroyed before the
+    // instance, their synchronization is up to their type.
+    template <typename Buffer>
+    requires std::default_initializable<Buffer>
+    class per_thread {
+    public:
+        using buffer_t = Buffer;
+
+        per_thread() = default;
+
+        per_thread(per_thread const &) = delete;
+        per_thread &operator=(per_thread const &) = delete;
+
+        per_thread(per_thread &&other) noexcept
+            : per_thread{} {
+            swap(other);
+        }
+
+        per_thread &operator=(per_thread &&other) noexcept {
+            per_thread{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        ~per_thread() { release_slot(m_slot); }
+
+        // Buffer of the calling thread, registered the first time the thread uses it. Each thread
+        // caches its buffers by slot, slots are reused once their instance is destroyed: the cache
+        // holds at most one entry per live instance.
+        [[nodiscard]] buffer_t &local() {
+            thread_local std::vector<cached_buffer> known{};
+            if (m_slot >= known.size()) { known.resize(m_slot + 1U); }
+            auto &entry = known[m_slot];
+            if (entry.id != m_id) { entry = cached_buffer{.id = m_id, .buffer = &add()}; }
+            return *entry.buffer;
+        }
+
+        // Buffer not owned by any thread
+        buffer_t &add() {
+            std::scoped_lock const lock{m_mutex};
+            auto &buffer = *m_buffers.emplace_back(std::make_unique<buffer_t>());
+            buffer.index = m_buffers.size() - 1U;
+            return buffer;
+        }
+
+        // f(buffer) is called for every buffer, while no buffer can be added
+        void for_each(auto &&f) const {
+            std::scoped_lock const registry_lock{m_mutex};
+            for (auto const &buffer : m_buffers) {
+                f(*buffer);
+            }
+        }
+
+        void swap(per_thread &other) noexcept {
+            std::scoped_lock const lock{m_mutex, other.m_mutex};
+            std::swap(m_id, other.m_id);
+            std::swap(m_slot, other.m_slot);
+            std::swap(m_buffers, other.m_buffers);
+        }
+
+    private:
+        struct cached_buffer {
+            std::uint64_t id{};
+            buffer_t *buffer{};
+        };
+
+        inline static std::atomic<std::uint64_t> next_id{1};
+        inline static std::mutex slots_mutex{};
+        inline static std::vector<std::size_t> free_slots{};
+        inline static std::size_t slot_count{};
+
+        static std::size_t acquire_slot() {
+            std::scoped_lock const lock{slots_mutex};
+            if (!free_slots.empty()) {
+                auto const slot = free_slots.back();
+                free_slots.pop_back();
+                return slot;
+            }
+            // Room for every slot to be released, so that release_slot never allocates
+            free_slots.reserve(slot_count + 1U);
+            return slot_count++;
+        }
+
+        static void release_slot(std::size_t slot) noexcept {
+            std::scoped_lock const lock{slots_mutex};
+            free_slots.push_back(slot);
+        }
+
+        // Identified by a unique id rather than the address or the slot, so that stale entries of
+        // destroyed instances are never matched
+        std::uint64_t m_id{next_id.fetch_add(1, std::memory_order_relaxed)};
+        std::size_t m_slot{acquire_slot()};
+        mutable std::mutex m_mutex{};
+        std::vector<std::unique_ptr<buffer_t>> m_buffers{};
+    };
+}  // namespace detail
+
+// Every thread records into its own buffer without locking, the buffers are drained into the
+// merged logger only when it is iterated or copied (e.g. by a reporter): the reader pays for the
+// synchronization, not the recording threads. Records are combined with merge(), for plain
+// durations the value drained last wins.
+template <time_logger Logger = default_logger<>>
+requires std::default_initializable<Logger>
+         && (duration<typename Logger::mapped_type> || detail::mergeable_record<typename Logger::mapped_type>)
+class concurrent_logger {
+public:
+    using key_type = std::string;
+    using mapped_type = typename Logger::mapped_type;
+    using value_type = std::ranges::range_value_t<Logger>;
+    using logger_t = Logger;
+
+private:
+    struct entry {
+        mapped_type value{};
+        // Whether value holds samples not drained yet
+        bool written{};
+    };
+
+    // Entries are never erased, so that resolved handles stay valid
+    using log_t = std::unordered_map<std::string, entry>;
+    using buffer_t = detail::double_buffer<log_t>;
+
+public:
+    // Assigning through the proxy writes into the buffer of the calling thread
+    class slot {
+    public:
+        slot(buffer_t &buffer, std::string key)
+            : m_buffer{buffer}
+            , m_key{std::move(key)} {}
+
+        slot &operator=(mapped_type value) {  // NOLINT(cppcoreguidelines-c-copy-assignment-signature, misc-unconventional-assign-operator)
+            m_buffer.get().write([this, &value](log_t &log, std::size_t) {
+                auto &written = log[m_key];
+                written.value = std::move(value);
+                written.written = true;
+            });
+            return *this;
+        }
+
+    private:
+        std::reference_wrapper<buffer_t> m_buffer;
+        std::string m_key;
+    };
+
+    // Handle to the entry of a section in both halves of the buffer of the calling thread, samples
+    // are recorded without hashing the key
+    class local_slot {
+    public:
+        local_slot(buffer_t &buffer, std::string key)
+            : m_buffer{&buffer}
+            , m_key{std::move(key)} {
+            m_buffer->write([this](log_t &log, std::size_t half) { resolve(log, half); });
+        }
+
+        void record(auto const &sample) {
+            m_buffer->write([this, &sample](log_t &log, std::size_t half) {
+                auto &resolved = resolve(log, half);
+                detail::log_sample(resolved.value, sample);
+                resolved.written = true;
+            });
+        }
+
+    private:
+        entry &resolve(log_t &log, std::size_t half) {
+            auto *&resolved = m_entries[half];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (resolved == nullptr) { resolved = &log[m_key]; }
+            return *resolved;
+        }
+
+        buffer_t *m_buffer;
+        std::string m_key;
+        std::array<entry *, 2> m_entries{};
+    };
+
+    concurrent_logger() = default;
+
+    concurrent_logger(concurrent_logger const &other)
+        : concurrent_logger{} {
+        m_merged = other.snapshot();
+    }
+
+    concurrent_logger(concurrent_logger &&other) noexcept
+        : concurrent_logger{} {
+        swap(other);
+    }
+
+    concurrent_logger &operator=(concurrent_logger const &other) {
+        if (this != &other) { concurrent_logger{other}.swap(*this); }
+        return *this;
+    }
+
+    concurrent_logger &operator=(concurrent_logger &&other) noexcept {
+        concurrent_logger{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    ~concurrent_logger() = default;
+
+    [[nodiscard]] slot operator[](std::string key) {
+        return slot{m_buffers.local(), std::move(key)};
+    }
+
+    // The handle must be used only by the calling thread
+    [[nodiscard]] local_slot resolve(std::string key) {
+        return local_slot{m_buffers.local(), std::move(key)};
+    }
+
+    void record(std::string const &key, auto const &sample) {
+        m_buffers.local().write([&key, &sample](log_t &log, std::size_t) {
+            auto &written = log[key];
+            detail::log_sample(written.value, sample);
+            written.written = true;
+        });
+    }
+
+    // Drains every thread buffer into the merged logger and returns it. The owners are switched to
+    // their other half first, a single heavy fence then covers all of them.
+    [[nodiscard]] Logger snapshot() const {
+        std::scoped_lock const lock{m_merge_mutex};
+        std::vector<std::pair<buffer_t *, std::size_t>> retired{};
+        m_buffers.for_each([&retired](buffer_t &buffer) { retired.emplace_back(&buffer, buffer.switch_half()); });
+        detail::heavy_fence();
+        for (auto const &[buffer, half] : retired) {
+            buffer->take(half, [this](log_t &log) { drain(log); });
+        }
+        return m_merged;
+    }
+
+    [[nodiscard]] auto begin() {
+        m_snapshot = snapshot();
+        return std::ranges::begin(m_snapshot);
+    }
+
+    [[nodiscard]] auto end() {
+        return std::ranges::end(m_snapshot);
+    }
+
+    void swap(concurrent_logger &other) noexcept {
+        std::scoped_lock const lock{m_merge_mutex, other.m_merge_mutex};
+        m_buffers.swap(other.m_buffers);
+        std::swap(m_merged, other.m_merged);
+        std::swap(m_snapshot, other.m_snapshot);
+    }
+
+private:
+    void drain(log_t &log) const {
+        for (auto &[key, drained] : log) {
+            auto &merged = m_merged[key];
+            if (!drained.written) { continue; }
+            if constexpr (detail::mergeable_record<mapped_type>) {
+                merged.merge(drained.value);
+                drained.value = mapped_type{};
+            } else {
+                merged = drained.value;
+            }
+            drained.written = false;
+        }
+    }
+
+    detail::per_thread<buffer_t> m_buffers{};
+    mutable std::mutex m_merge_mutex{};
+    mutable Logger m_merged{};
+    Logger m_snapshot{};
+};
+}  // namespace cpputils::benchmark
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef CPPUTILS_BENCHMARK_CPU_HPP
+#define CPPUTILS_BENCHMARK_CPU_HPP
+
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include "system_macros.hpp"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#ifdef CPPUTILS_POSIX_PLATFORM
+#include <ctime>
+#endif
+
+#ifdef CPPUTILS_LINUX_PLATFORM
+#include <sys/resource.h>
+#endif
+
+namespace cpputils::benchmark {
+
+// Wall time, CPU time of the thread and context switches of a single measure. A section whose CPU
+// time is much lower than its wall time was waiting (I/O, locks, preemption); voluntary switches
+// tell blocking apart from involuntary ones caused by the scheduler.
+template <duration D>
+struct cpu_measurement {
+    D elapsed{};
+    std::chrono::nanoseconds cpu_time{};
+    std::uint64_t voluntary_switches{};
+    std::uint64_t involuntary_switches{};
+    // CPU time is available on POSIX systems, context switches on Linux
+    bool cpu_time_available{};
+    bool switches_available{};
+};
+
+namespace detail {
+    struct cpu_usage {
+        std::chrono::nanoseconds cpu_time{};
+        std::uint64_t voluntary_switches{};
+        std::uint64_t involuntary_switches{};
+        bool cpu_time_available{};
+        bool switches_available{};
+    };
+
+    [[nodiscard]] inline cpu_usage thread_cpu_usage() noexcept {
+        cpu_usage usage{};
+#ifdef CPPUTILS_POSIX_PLATFORM
+        timespec cpu{};
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu) == 0) {
+            usage.cpu_time = std::chrono::seconds{cpu.tv_sec} + std::chrono::nanoseconds{cpu.tv_nsec};
+            usage.cpu_time_available = true;
+        }
+#endif
+#ifdef CPPUTILS_LINUX_PLATFORM
+        rusage resources{};
+        if (getrusage(RUSAGE_THREAD, &resources) == 0) {
+            usage.voluntary_switches = static_cast<std::uint64_t>(resources.ru_nvcsw);
+            usage.involuntary_switches = static_cast<std::uint64_t>(resources.ru_nivcsw);
+            usage.switches_available = true;
+        }
+#endif
+        return usage;
+    }
+}  // namespace detail
+
+// Measures wall time with Clock, and CPU time and context switches of the calling thread. A counter
+// must be started and stopped by the same thread.
+template <typename Clock = default_clock>
+class cpu_counter {
+public:
+    using clock_t = Clock;
+
+    void start() {
+        m_start_usage = detail::thread_cpu_usage();
+        m_start = Clock::now();
+    }
+
+    void stop() {
+        m_stop = Clock::now();
+        m_stop_usage = detail::thread_cpu_usage();
+    }
+
+    [[nodiscard]] duration auto delta() const {
+        return m_stop - m_start;
+    }
+
+    [[nodiscard]] cpu_measurement<typename Clock::duration> measurement() const {
+        return {
+            .elapsed = delta(),
+            .cpu_time = m_stop_usage.cpu_time - m_start_usage.cpu_time,
+            .voluntary_switches = m_stop_usage.voluntary_switches - m_start_usage.voluntary_switches,
+            .involuntary_switches = m_stop_usage.involuntary_switches - m_start_usage.involuntary_switches,
+            .cpu_time_available = m_start_usage.cpu_time_available && m_stop_usage.cpu_time_available,
+            .switches_available = m_start_usage.switches_available && m_stop_usage.switches_available,
+        };
+    }
+
+private:
+    std::chrono::time_point<Clock> m_start{};
+    std::chrono::time_point<Clock> m_stop{};
+    detail::cpu_usage m_start_usage{};
+    detail::cpu_usage m_stop_usage{};
+};
+
+// Record of a section measured with cpu_counter: mean wall and CPU time, the fraction of the wall
+// time spent on CPU and the mean context switches per measure. Unavailable values are nan.
+template <duration D = default_duration>
+class cpu_record : public detail::mean_record<D> {
+    using base_t = detail::mean_record<D>;
+
+public:
+    using base_t::record;
+
+    template <duration E>
+    void record(cpu_measurement<E> const &measurement) {
+        auto const elapsed = std::chrono::duration_cast<D>(measurement.elapsed);
+        record(elapsed);
+        if (measurement.cpu_time_available) {
+            ++m_cpu_count;
+            m_cpu_total += measurement.cpu_time;
+            m_cpu_wall_total += elapsed;
+        }
+        if (measurement.switches_available) {
+            ++m_switch_count;
+            m_voluntary += measurement.voluntary_switches;
+            m_involuntary += measurement.involuntary_switches;
+        }
+    }
+
+    void merge(cpu_record const &other) {
+        base_t::merge(other);
+        m_cpu_count += other.m_cpu_count;
+        m_cpu_total += other.m_cpu_total;
+        m_cpu_wall_total += other.m_cpu_wall_total;
+        m_switch_count += other.m_switch_count;
+        m_voluntary += other.m_voluntary;
+        m_involuntary += other.m_involuntary;
+    }
+
+    [[nodiscard]] double cpu_time() const {
+        if (m_cpu_count == 0U) { return std::numeric_limits<double>::quiet_NaN(); }
+        return std::chrono::duration<double, typename D::period>{m_cpu_total}.count() / static_cast<double>(m_cpu_count);
+    }
+
+    // CPU time over wall time of the measures where both are known: close to 1 for compute bound
+    // sections, close to 0 for sections waiting most of the time
+    [[nodiscard]] double cpu_utilization() const {
+        if (m_cpu_count == 0U) { return std::numeric_limits<double>::quiet_NaN(); }
+        return std::chrono::duration<double>{m_cpu_total}.count() / std::chrono::duration<double>{m_cpu_wall_total}.count();
+    }
+
+    [[nodiscard]] double voluntary_switches() const { return per_switch_measure(m_voluntary); }
+    [[nodiscard]] double involuntary_switches() const { return per_switch_measure(m_involuntary); }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"samples"}, this->count());
+        f(std::string_view{"elapsed"}, this->elapsed());
+        f(std::string_view{"cpu_time"}, cpu_time());
+        f(std::string_view{"cpu_utilization"}, cpu_utilization());
+        f(std::string_view{"voluntary_switches"}, voluntary_switches());
+        f(std::string_view{"involuntary_switches"}, involuntary_switches());
+    }
+
+private:
+    std::uint64_t m_cpu_count{};
+    std::chrono::nanoseconds m_cpu_total{};
+    D m_cpu_wall_total{};
+    std::uint64_t m_switch_count{};
+    std::uint64_t m_voluntary{};
+    std::uint64_t m_involuntary{};
+
+    [[nodiscard]] double per_switch_measure(std::uint64_t total) const {
+        if (m_switch_count == 0U) { return std::numeric_limits<double>::quiet_NaN(); }
+        return static_cast<double>(total) / static_cast<double>(m_switch_count);
+    }
+};
+
+template <duration D = default_duration>
+using cpu_logger = std::unordered_map<std::string, cpu_record<D>>;
+}  // namespace cpputils::benchmark
+
+#endif
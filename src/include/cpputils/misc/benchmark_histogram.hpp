@@ -0,0 +1,134 @@
+#ifndef CPPUTILS_BENCHMARK_HISTOGRAM_HPP
+#define CPPUTILS_BENCHMARK_HISTOGRAM_HPP
+
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cpputils::benchmark {
+
+// Log-linear (HDR-style) histogram: values below 2^Precision are counted exactly, larger values
+// fall in buckets whose width is at most 2^-(Precision - 1) times the value.
+// The memory used does not depend on the number of samples.
+template <duration D = default_duration, unsigned Precision = 7>
+requires (Precision > 1 && Precision < 16)
+class histogram {
+    static constexpr std::uint64_t linear_buckets = std::uint64_t{1} << Precision;
+    static constexpr std::uint64_t half_buckets = linear_buckets / 2U;
+    static constexpr std::size_t bucket_count = linear_buckets + (64U - Precision) * half_buckets;
+
+public:
+    using duration_t = D;
+
+    void record(D sample) {
+        auto const value = to_value(sample);
+        ++m_counts[index_of(value)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (m_count == 0U || value < m_min) { m_min = value; }
+        if (m_count == 0U || value > m_max) { m_max = value; }
+        ++m_count;
+        m_sum += value;
+    }
+
+    void merge(histogram const &other) {
+        if (other.m_count == 0U) { return; }
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            m_counts[i] += other.m_counts[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        m_min = m_count == 0U ? other.m_min : std::min(m_min, other.m_min);
+        m_max = m_count == 0U ? other.m_max : std::max(m_max, other.m_max);
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return m_count; }
+    [[nodiscard]] D sum() const { return from_value(m_sum); }
+    [[nodiscard]] D min() const { return from_value(m_min); }
+    [[nodiscard]] D max() const { return from_value(m_max); }
+    [[nodiscard]] D median() const { return percentile(0.5); }
+
+    [[nodiscard]] D mean() const {
+        if (m_count == 0U) { return D{}; }
+        return detail::duration_from_count<D>(static_cast<double>(m_sum) / static_cast<double>(m_count));
+    }
+
+    // q in [0, 1], the result is exact up to the bucket resolution
+    [[nodiscard]] D percentile(double q) const {
+        if (m_count == 0U) { return D{}; }
+        auto const wanted = std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(m_count));
+        auto const rank = std::max(std::uint64_t{1}, static_cast<std::uint64_t>(wanted));
+        std::uint64_t seen{};
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            seen += m_counts[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (seen >= rank) {
+                return from_value(std::clamp(middle_of(i), m_min, m_max));
+            }
+        }
+        return max();
+    }
+
+    [[nodiscard]] D elapsed() const { return median(); }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"count"}, count());
+        f(std::string_view{"sum"}, sum());
+        f(std::string_view{"min"}, min());
+        f(std::string_view{"mean"}, mean());
+        f(std::string_view{"p50"}, median());
+        f(std::string_view{"p90"}, percentile(0.9));  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        f(std::string_view{"p99"}, percentile(0.99));  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        f(std::string_view{"p999"}, percentile(0.999));  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        f(std::string_view{"max"}, max());
+    }
+
+private:
+    std::array<std::uint64_t, bucket_count> m_counts{};
+    std::uint64_t m_count{};
+    std::uint64_t m_sum{};
+    std::uint64_t m_min{};
+    std::uint64_t m_max{};
+
+    // Negative samples are clamped to zero
+    [[nodiscard]] static std::uint64_t to_value(D sample) {
+        auto const count = sample.count();
+        if (count <= 0) { return 0U; }
+        if constexpr (std::chrono::treat_as_floating_point_v<typename D::rep>) {
+            return static_cast<std::uint64_t>(std::llround(count));
+        } else {
+            return static_cast<std::uint64_t>(count);
+        }
+    }
+
+    [[nodiscard]] static D from_value(std::uint64_t value) {
+        return D{static_cast<typename D::rep>(value)};
+    }
+
+    [[nodiscard]] static std::size_t index_of(std::uint64_t value) {
+        if (value < linear_buckets) { return static_cast<std::size_t>(value); }
+        auto const shift = static_cast<unsigned>(std::bit_width(value)) - Precision;
+        auto const sub_bucket = (value >> shift) - half_buckets;
+        return static_cast<std::size_t>(linear_buckets + (shift - 1U) * half_buckets + sub_bucket);
+    }
+
+    [[nodiscard]] static std::uint64_t middle_of(std::size_t index) {
+        if (index < linear_buckets) { return index; }
+        auto const offset = index - linear_buckets;
+        auto const shift = static_cast<unsigned>(offset / half_buckets) + 1U;
+        auto const lower = (offset % half_buckets + half_buckets) << shift;
+        return lower + ((std::uint64_t{1} << shift) - 1U) / 2U;
+    }
+};
+
+template <duration D = default_duration, unsigned Precision = 7>
+using histogram_logger = std::unordered_map<std::string, histogram<D, Precision>>;
+}  // namespace cpputils::benchmark
+
+#endif
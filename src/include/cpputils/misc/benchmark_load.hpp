@@ -0,0 +1,173 @@
+#ifndef CPPUTILS_BENCHMARK_LOAD_HPP
+#define CPPUTILS_BENCHMARK_LOAD_HPP
+
+#include "benchmark.hpp"
+#include "benchmark_histogram.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpputils::benchmark {
+
+// Latency of a single call of an open-loop run: from the time the call was scheduled, and from the
+// time it actually started
+template <duration D>
+struct load_sample {
+    D latency{};
+    D service_time{};
+};
+
+// Latencies of an open-loop run at a target rate, together with the rate actually achieved.
+// Latency is measured from the scheduled start of each call: when the callable falls behind, the
+// time calls spend waiting for the previous ones is included (no coordinated omission).
+// Service time is measured from the actual start.
+template <duration D = default_duration, unsigned Precision = 7>
+class load_record {
+public:
+    using duration_t = D;
+
+    void record(D latency) {
+        m_latency.record(latency);
+    }
+
+    template <duration E>
+    void record(load_sample<E> const &sample) {
+        m_latency.record(std::chrono::duration_cast<D>(sample.latency));
+        m_service_time.record(std::chrono::duration_cast<D>(sample.service_time));
+    }
+
+    // Merged records are taken as runs fired concurrently: their rates add up
+    void merge(load_record const &other) {
+        m_latency.merge(other.m_latency);
+        m_service_time.merge(other.m_service_time);
+        m_target_rate += other.m_target_rate;
+        m_achieved_rate += other.m_achieved_rate;
+    }
+
+    // Calls per second
+    void set_rates(double target, double achieved) noexcept {
+        m_target_rate = target;
+        m_achieved_rate = achieved;
+    }
+
+    [[nodiscard]] double target_rate() const noexcept { return m_target_rate; }
+    [[nodiscard]] double achieved_rate() const noexcept { return m_achieved_rate; }
+    [[nodiscard]] histogram<D, Precision> const &latency() const noexcept { return m_latency; }
+    [[nodiscard]] histogram<D, Precision> const &service_time() const noexcept { return m_service_time; }
+
+    [[nodiscard]] D elapsed() const { return m_latency.elapsed(); }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"target_rate"}, target_rate());
+        f(std::string_view{"achieved_rate"}, achieved_rate());
+        m_latency.for_each_field(f);
+        f(std::string_view{"service_p50"}, m_service_time.median());
+        f(std::string_view{"service_p99"}, m_service_time.percentile(0.99));  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    }
+
+private:
+    histogram<D, Precision> m_latency{};
+    histogram<D, Precision> m_service_time{};
+    double m_target_rate{};
+    double m_achieved_rate{};
+};
+
+template <duration D = default_duration, unsigned Precision = 7>
+using load_logger = std::unordered_map<std::string, load_record<D, Precision>>;
+
+struct load_options {
+    // Target rates, in calls per second. Each one is a separate run.
+    std::vector<double> rates{};
+    // Length of the schedule of each run
+    std::chrono::nanoseconds duration{std::chrono::seconds{1}};
+};
+
+namespace detail {
+    // Sleeps while the deadline is far, then spins: sleeping alone overshoots by the scheduler latency
+    template <typename Clock>
+    void wait_until(typename Clock::time_point deadline) {
+        constexpr auto spin_threshold = std::chrono::microseconds{100};
+        for (auto now = Clock::now(); now < deadline; now = Clock::now()) {
+            if (deadline - now > spin_threshold) { std::this_thread::sleep_for(deadline - now - spin_threshold); }
+        }
+    }
+
+    // Shortest decimal form of the rate that reads back as the same value, without exponent
+    [[nodiscard]] inline std::string rate_label(double rate) {
+        std::array<char, 512> buffer{};  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        auto const [last, error] = std::to_chars(buffer.data(), std::next(buffer.data(), static_cast<std::ptrdiff_t>(buffer.size())), rate, std::chars_format::fixed);
+        if (error != std::errc{}) { return std::to_string(rate); }
+        return std::string{buffer.data(), last};
+    }
+}  // namespace detail
+
+// Open-loop load generator: calls are scheduled at a fixed rate and fired at their scheduled time,
+// or immediately if the previous calls are late. Every rate is logged in section "name/rate", so a
+// report of the logger is a latency vs throughput curve.
+template <duration D = default_duration, unsigned Precision = 7, typename Clock = default_clock>
+class load_generator {
+public:
+    using logger_t = load_logger<D, Precision>;
+    using record_t = load_record<D, Precision>;
+
+    explicit load_generator(logger_t &logger, load_options options)
+        : m_logger{logger}
+        , m_options{std::move(options)} {}
+
+    [[nodiscard]] load_options const &options() const noexcept { return m_options; }
+
+    // The records of the runs, in the order of the rates. Rates that are not positive are skipped.
+    template <typename F>
+    requires std::invocable<F &>
+    std::vector<record_t> run(std::string const &name, F &&f) {
+        std::vector<record_t> records{};
+        for (auto const rate : m_options.rates) {
+            if (!(rate > 0.0)) { continue; }
+            auto record = run_at(rate, f);
+            m_logger.get()[name + "/" + detail::rate_label(rate)] = record;
+            records.push_back(std::move(record));
+        }
+        return records;
+    }
+
+private:
+    std::reference_wrapper<logger_t> m_logger;
+    load_options m_options;
+
+    record_t run_at(double rate, auto &f) const {
+        auto const period = std::chrono::duration<double>{1.0 / rate};
+        auto const calls = static_cast<std::uint64_t>(std::max(1LL, std::llround(std::chrono::duration<double>{m_options.duration}.count() * rate)));
+        record_t record{};
+        auto const start = Clock::now();
+        auto last_end = start;
+        for (std::uint64_t i = 0; i < calls; ++i) {
+            auto const scheduled = start + std::chrono::duration_cast<typename Clock::duration>(period * static_cast<double>(i));
+            detail::wait_until<Clock>(scheduled);
+            auto const actual = Clock::now();
+            detail::invoke_and_keep(f);
+            last_end = Clock::now();
+            record.record(load_sample<D>{
+                .latency = std::chrono::duration_cast<D>(last_end - scheduled),
+                .service_time = std::chrono::duration_cast<D>(last_end - actual),
+            });
+        }
+        auto const elapsed = std::chrono::duration<double>{last_end - start}.count();
+        record.set_rates(rate, elapsed > 0.0 ? static_cast<double>(calls) / elapsed : 0.0);
+        return record;
+    }
+};
+}  // namespace cpputils::benchmark
+
+#endif
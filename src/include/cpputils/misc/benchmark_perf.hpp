@@ -0,0 +1,294 @@
+#ifndef CPPUTILS_BENCHMARK_PERF_HPP
+#define CPPUTILS_BENCHMARK_PERF_HPP
+
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include "system_macros.hpp"
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#ifdef CPPUTILS_LINUX_PLATFORM
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cpputils::benchmark {
+
+enum class perf_event : std::uint8_t {
+    cycles,
+    instructions,
+    branch_misses,
+    cache_misses,
+    task_clock,
+    page_faults,
+    context_switches,
+};
+
+inline constexpr std::size_t perf_event_count = 7;
+
+inline constexpr std::array<std::string_view, perf_event_count> perf_event_names{
+    "cycles",
+    "instructions",
+    "branch_misses",
+    "cache_misses",
+    "task_clock",
+    "page_faults",
+    "context_switches",
+};
+
+using perf_event_set = std::bitset<perf_event_count>;
+
+// Elapsed time and event counts of a single measure. Only the events in `available` are meaningful.
+template <duration D>
+struct perf_measurement {
+    D elapsed{};
+    std::array<std::uint64_t, perf_event_count> values{};
+    perf_event_set available{};
+
+    [[nodiscard]] std::uint64_t operator[](perf_event event) const {
+        return values[static_cast<std::size_t>(event)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+};
+
+namespace detail {
+    // The events counted for the calling thread: hardware events if the PMU is accessible,
+    // software events otherwise
+    class perf_group {
+    public:
+        using values_t = std::array<std::uint64_t, perf_event_count>;
+
+        // Raw counts, with the time the group was enabled and actually counting on the PMU
+        struct reading {
+            values_t values{};
+            std::uint64_t time_enabled{};
+            std::uint64_t time_running{};
+        };
+
+#ifdef CPPUTILS_LINUX_PLATFORM
+        perf_group() {
+            open_events(PERF_TYPE_HARDWARE, perf_event::cycles, perf_event::cache_misses);
+            if (m_size == 0U) {
+                open_events(PERF_TYPE_SOFTWARE, perf_event::task_clock, perf_event::context_switches);
+            }
+            if (m_size > 0U) {
+                ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);  // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+                ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);  // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+            }
+        }
+
+        ~perf_group() {
+            for (std::size_t i = 0; i < m_size; ++i) {
+                close(m_fds[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+
+        [[nodiscard]] reading read() const {
+            reading result{};
+            if (m_size == 0U) { return result; }
+            // Layout: number of events, time enabled, time running, then the values in opening order
+            std::array<std::uint64_t, perf_event_count + 3U> buffer{};
+            auto const expected = static_cast<ssize_t>((m_size + 3U) * sizeof(std::uint64_t));
+            if (::read(m_leader, buffer.data(), sizeof(buffer)) < expected) { return result; }
+            result.time_enabled = buffer[1];
+            result.time_running = buffer[2];
+            for (std::size_t i = 0; i < m_size; ++i) {
+                result.values[static_cast<std::size_t>(m_events[i])] = buffer[i + 3U];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+            return result;
+        }
+#else
+        perf_group() = default;
+        ~perf_group() = default;
+
+        [[nodiscard]] reading read() const { return {}; }
+#endif
+        perf_group(perf_group const &) = delete;
+        perf_group(perf_group &&) = delete;
+        perf_group &operator=(perf_group const &) = delete;
+        perf_group &operator=(perf_group &&) = delete;
+
+        [[nodiscard]] perf_event_set available() const noexcept { return m_available; }
+
+    private:
+        int m_leader{-1};
+        std::array<int, perf_event_count> m_fds{};
+        std::array<perf_event, perf_event_count> m_events{};
+        std::size_t m_size{};
+        perf_event_set m_available{};
+
+#ifdef CPPUTILS_LINUX_PLATFORM
+        [[nodiscard]] static std::uint64_t config_of(perf_event event) {
+            switch (event) {
+            case perf_event::cycles: return PERF_COUNT_HW_CPU_CYCLES;
+            case perf_event::instructions: return PERF_COUNT_HW_INSTRUCTIONS;
+            case perf_event::branch_misses: return PERF_COUNT_HW_BRANCH_MISSES;
+            case perf_event::cache_misses: return PERF_COUNT_HW_CACHE_MISSES;
+            case perf_event::task_clock: return PERF_COUNT_SW_TASK_CLOCK;
+            case perf_event::page_faults: return PERF_COUNT_SW_PAGE_FAULTS;
+            case perf_event::context_switches: return PERF_COUNT_SW_CONTEXT_SWITCHES;
+            }
+            return 0U;
+        }
+
+        [[nodiscard]] int open_event(perf_event_attr attr, bool exclude_kernel) const {
+            attr.exclude_kernel = exclude_kernel ? 1U : 0U;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0UL));  // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+        }
+
+        // Events that cannot be opened (no PMU, not permitted, not supported) are skipped. Hardware
+        // events exclude the kernel. Page faults and context switches happen in the kernel: they are
+        // counted with the kernel included or not at all, the task clock counts the same either way.
+        void open_events(std::uint32_t type, perf_event first, perf_event last) {
+            for (auto e = static_cast<std::size_t>(first); e <= static_cast<std::size_t>(last); ++e) {
+                auto const event = static_cast<perf_event>(e);
+                perf_event_attr attr{};
+                attr.type = type;
+                attr.size = sizeof(attr);
+                attr.config = config_of(event);
+                attr.disabled = m_size == 0U ? 1U : 0U;
+                attr.exclude_hv = 1U;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                auto fd = open_event(attr, type == PERF_TYPE_HARDWARE);
+                if (fd < 0 && event == perf_event::task_clock) { fd = open_event(attr, true); }
+                if (fd < 0) { continue; }
+                if (m_size == 0U) { m_leader = fd; }
+                m_fds[m_size] = fd;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                m_events[m_size] = event;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                ++m_size;
+                m_available.set(e);
+            }
+        }
+#endif
+    };
+
+    [[nodiscard]] inline perf_group const &thread_perf_group() {
+        thread_local perf_group const group{};
+        return group;
+    }
+
+    // Counts between two readings. When the PMU was shared with other groups, the counts are
+    // scaled by the time the group was enabled over the time it was counting.
+    [[nodiscard]] inline perf_group::values_t scaled_delta(perf_group::reading const &start, perf_group::reading const &stop) {
+        auto const enabled = stop.time_enabled - start.time_enabled;
+        auto const running = stop.time_running - start.time_running;
+        perf_group::values_t values{};
+        for (std::size_t i = 0; i < perf_event_count; ++i) {
+            values[i] = stop.values[i] - start.values[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (running > 0U && running < enabled) {
+                auto const scaled = static_cast<double>(values[i]) * static_cast<double>(enabled) / static_cast<double>(running);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                values[i] = static_cast<std::uint64_t>(std::llround(scaled));  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+        return values;
+    }
+}  // namespace detail
+
+// Counts hardware events (cycles, instructions, branch and cache misses) of the calling thread
+// around a section, or software events (task clock, page faults, context switches) if the PMU is
+// not accessible. The event descriptors are opened once per thread: a counter must be started and
+// stopped by the same thread. Counts multiplexed with other events are scaled to the whole section.
+template <typename Clock = default_clock>
+class perf_counter {
+public:
+    using clock_t = Clock;
+
+    [[nodiscard]] static perf_event_set available_events() {
+        return detail::thread_perf_group().available();
+    }
+
+    void start() {
+        m_start_reading = detail::thread_perf_group().read();
+        m_start = Clock::now();
+    }
+
+    void stop() {
+        m_stop = Clock::now();
+        m_stop_reading = detail::thread_perf_group().read();
+    }
+
+    [[nodiscard]] duration auto delta() const {
+        return m_stop - m_start;
+    }
+
+    [[nodiscard]] perf_measurement<typename Clock::duration> measurement() const {
+        return perf_measurement<typename Clock::duration>{
+            .elapsed = delta(),
+            .values = detail::scaled_delta(m_start_reading, m_stop_reading),
+            .available = available_events(),
+        };
+    }
+
+private:
+    std::chrono::time_point<Clock> m_start{};
+    std::chrono::time_point<Clock> m_stop{};
+    detail::perf_group::reading m_start_reading{};
+    detail::perf_group::reading m_stop_reading{};
+};
+
+// Record of a section measured with perf_counter: mean elapsed time, mean count of every event per
+// measure and instructions per cycle. Events that were never available are reported as nan.
+template <duration D = default_duration>
+class perf_record : public detail::mean_record<D> {
+    using base_t = detail::mean_record<D>;
+
+public:
+    using base_t::record;
+
+    template <duration E>
+    void record(perf_measurement<E> const &measurement) {
+        record(std::chrono::duration_cast<D>(measurement.elapsed));
+        for (std::size_t i = 0; i < perf_event_count; ++i) {
+            if (measurement.available.test(i)) {
+                m_event_totals[i] += measurement.values[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                ++m_event_counts[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+    }
+
+    void merge(perf_record const &other) {
+        base_t::merge(other);
+        for (std::size_t i = 0; i < perf_event_count; ++i) {
+            m_event_totals[i] += other.m_event_totals[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            m_event_counts[i] += other.m_event_counts[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    }
+
+    [[nodiscard]] double mean(perf_event event) const {
+        auto const i = static_cast<std::size_t>(event);
+        if (m_event_counts[i] == 0U) { return std::numeric_limits<double>::quiet_NaN(); }  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        return static_cast<double>(m_event_totals[i]) / static_cast<double>(m_event_counts[i]);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    [[nodiscard]] double instructions_per_cycle() const {
+        return mean(perf_event::instructions) / mean(perf_event::cycles);
+    }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"samples"}, this->count());
+        f(std::string_view{"elapsed"}, this->elapsed());
+        for (std::size_t i = 0; i < perf_event_count; ++i) {
+            f(perf_event_names[i], mean(static_cast<perf_event>(i)));  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        f(std::string_view{"ipc"}, instructions_per_cycle());
+    }
+
+private:
+    std::array<std::uint64_t, perf_event_count> m_event_totals{};
+    std::array<std::uint64_t, perf_event_count> m_event_counts{};
+};
+
+template <duration D = default_duration>
+using perf_logger = std::unordered_map<std::string, perf_record<D>>;
+}  // namespace cpputils::benchmark
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef CPPUTILS_BENCHMARK_PROFILE_HPP
+#define CPPUTILS_BENCHMARK_PROFILE_HPP
+
+// CPPUTILS_PROFILE_SCOPE("name") times the rest of the enclosing scope, CPPUTILS_PROFILE_FUNCTION()
+// the rest of the enclosing function, labelled with its name. Both write to the static logger of
+// timer<profile_logger_t>, a concurrent_logger<> unless CPPUTILS_PROFILE_LOGGER names another type:
+// the macros may run on any thread, another logger must be thread-safe as well.
+// Unless CPPUTILS_ENABLE_PROFILING is defined before the include they expand to a no-op
+// expression: no logger, no label and no timer is compiled in.
+
+#ifdef CPPUTILS_ENABLE_PROFILING
+
+#include "benchmark.hpp"
+#include "benchmark_concurrent.hpp"
+#include <source_location>
+
+#ifndef CPPUTILS_PROFILE_LOGGER
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define CPPUTILS_PROFILE_LOGGER ::cpputils::benchmark::concurrent_logger<>
+#endif
+
+namespace cpputils::benchmark {
+using profile_logger_t = CPPUTILS_PROFILE_LOGGER;
+using profile_timer_t = timer<profile_logger_t>;
+
+// The logger the profiling macros write to
+[[nodiscard]] inline profile_logger_t &profile_logger() {
+    return get_static_logger<profile_logger_t>();
+}
+}  // namespace cpputils::benchmark
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define CPPUTILS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CPPUTILS_PROFILE_CONCAT(a, b) CPPUTILS_PROFILE_CONCAT_IMPL(a, b)
+#define CPPUTILS_PROFILE_VARIABLE(prefix) CPPUTILS_PROFILE_CONCAT(prefix, __LINE__)
+
+// The section is looked up once per thread, name must be a string literal
+#define CPPUTILS_PROFILE_SCOPE(name)                                                                                   \
+    ::cpputils::benchmark::profile_timer_t::scoped const CPPUTILS_PROFILE_VARIABLE(cpputils_profile_scope_) {          \
+        ::cpputils::benchmark::profile_timer_t::static_section<name>()                                                 \
+    }
+
+#define CPPUTILS_PROFILE_FUNCTION()                                                                                    \
+    thread_local ::cpputils::benchmark::profile_timer_t::section CPPUTILS_PROFILE_VARIABLE(cpputils_profile_section_){ \
+        ::cpputils::benchmark::profile_logger(), std::source_location::current().function_name()};                     \
+    ::cpputils::benchmark::profile_timer_t::scoped const CPPUTILS_PROFILE_VARIABLE(cpputils_profile_function_) {       \
+        CPPUTILS_PROFILE_VARIABLE(cpputils_profile_section_)                                                           \
+    }
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#else
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define CPPUTILS_PROFILE_SCOPE(name) static_cast<void>(0)
+#define CPPUTILS_PROFILE_FUNCTION() static_cast<void>(0)
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#endif
+
+#endif
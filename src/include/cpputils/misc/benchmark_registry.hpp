@@ -0,0 +1,215 @@
+#ifndef CPPUTILS_BENCHMARK_REGISTRY_HPP
+#define CPPUTILS_BENCHMARK_REGISTRY_HPP
+
+#include "../functional/utils.hpp"
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include "benchmark_runner.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cpputils::benchmark {
+
+enum class complexity : std::uint8_t {
+    constant,
+    logarithmic,
+    linear,
+    linearithmic,
+    quadratic,
+};
+
+[[nodiscard]] inline std::string_view to_string(complexity c) noexcept {
+    switch (c) {
+    case complexity::constant: return "O(1)";
+    case complexity::logarithmic: return "O(log n)";
+    case complexity::linear: return "O(n)";
+    case complexity::linearithmic: return "O(n log n)";
+    case complexity::quadratic: return "O(n^2)";
+    }
+    return "";
+}
+
+// time(n) ~= coefficient * f(n). rms is the root mean square of the residuals relative to the
+// mean time: the lower, the better the fit.
+struct complexity_fit {
+    complexity best{};
+    double coefficient{};
+    double rms{};
+};
+
+// A point is an input size and the time measured for it
+using complexity_point = std::pair<std::size_t, double>;
+
+namespace detail {
+    inline constexpr std::array<complexity, 5> complexities{
+        complexity::constant,
+        complexity::logarithmic,
+        complexity::linear,
+        complexity::linearithmic,
+        complexity::quadratic,
+    };
+
+    [[nodiscard]] inline double complexity_term(complexity c, std::size_t size) {
+        auto const n = static_cast<double>(size);
+        switch (c) {
+        case complexity::constant: return 1.0;
+        case complexity::logarithmic: return std::log2(std::max(n, 2.0));
+        case complexity::linear: return n;
+        case complexity::linearithmic: return n * std::log2(std::max(n, 2.0));
+        case complexity::quadratic: return n * n;
+        }
+        return 1.0;
+    }
+}  // namespace detail
+
+// Least squares fit of the points to each complexity, the one with the lowest rms wins.
+// At least two different sizes are needed.
+[[nodiscard]] inline std::optional<complexity_fit> fit_complexity(std::span<complexity_point const> points) {
+    auto const distinct_sizes = std::ranges::any_of(points, [&points](auto const &p) { return p.first != points.front().first; });
+    if (!distinct_sizes) { return std::nullopt; }
+    double mean_time{};
+    for (auto const &[size, time] : points) { mean_time += time; }
+    mean_time /= static_cast<double>(points.size());
+
+    std::optional<complexity_fit> best{};
+    for (auto const c : detail::complexities) {
+        double time_by_term{};
+        double term_squared{};
+        for (auto const &[size, time] : points) {
+            auto const term = detail::complexity_term(c, size);
+            time_by_term += time * term;
+            term_squared += term * term;
+        }
+        auto const coefficient = time_by_term / term_squared;
+        double residuals{};
+        for (auto const &[size, time] : points) {
+            auto const residual = time - coefficient * detail::complexity_term(c, size);
+            residuals += residual * residual;
+        }
+        auto const rms = std::sqrt(residuals / static_cast<double>(points.size())) / (mean_time > 0.0 ? mean_time : 1.0);
+        if (!best || rms < best->rms) { best = complexity_fit{.best = c, .coefficient = coefficient, .rms = rms}; }
+    }
+    return best;
+}
+
+// first, first * multiplier, first * multiplier^2, ... up to last (included)
+[[nodiscard]] inline std::vector<std::size_t> size_range(std::size_t first, std::size_t last, std::size_t multiplier = 2) {
+    assert(first > 0U && multiplier > 1U);
+    std::size_t count{};
+    for (auto n = first; n <= last; n *= multiplier) {
+        ++count;
+        // The next size would wrap around past last
+        if (n > last / multiplier) { break; }
+    }
+    return make_range<std::vector<std::size_t>>([n = first, multiplier]() mutable { return std::exchange(n, n * multiplier); }, count);
+}
+
+// Result of a registered benchmark over its parameter space
+struct complexity_result {
+    std::string name{};
+    std::string_view time_unit{};
+    std::vector<complexity_point> points{};
+    std::optional<complexity_fit> fit{};
+};
+
+// Benchmarks declared once with the input sizes to run them with. run() times every
+// benchmark for every size with a runner, logging section "name/size", and fits the
+// complexity of each benchmark to the elapsed time of its records.
+template <time_logger Logger = statistics_logger<>, time_counter TimeCounter = default_counter<>>
+class registry {
+public:
+    using logger_t = Logger;
+    using runner_t = runner<Logger, TimeCounter>;
+
+    // f(n) is timed for every size
+    template <std::invocable<std::size_t> F>
+    registry &add(std::string name, std::vector<std::size_t> sizes, F f) {
+        m_benchmarks.push_back(entry{
+            .name = std::move(name),
+            .sizes = std::move(sizes),
+            .run = [f = std::move(f)](runner_t &r, std::string section, std::size_t n) mutable { return r.run(std::move(section), f, n); },
+        });
+        return *this;
+    }
+
+    // make_input(n) is not timed, f(input) is. The same input is passed to every call of f.
+    template <std::invocable<std::size_t> MakeInput, typename F>
+    requires std::invocable<F &, std::invoke_result_t<MakeInput &, std::size_t> &>
+    registry &add(std::string name, std::vector<std::size_t> sizes, MakeInput make_input, F f) {
+        m_benchmarks.push_back(entry{
+            .name = std::move(name),
+            .sizes = std::move(sizes),
+            .run = [make_input = std::move(make_input), f = std::move(f)](runner_t &r, std::string section, std::size_t n) mutable {
+                auto input = make_input(n);
+                return r.run(std::move(section), f, input);
+            },
+        });
+        return *this;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_benchmarks.size(); }
+
+    std::vector<complexity_result> run(Logger &logger, run_options options = {}) {
+        runner_t r{logger, options};
+        std::vector<complexity_result> results{};
+        results.reserve(m_benchmarks.size());
+        for (auto &benchmark : m_benchmarks) {
+            auto &result = results.emplace_back(complexity_result{.name = benchmark.name, .time_unit = detail::detect_time_unit<typename runner_t::duration_t>()});
+            for (auto const n : benchmark.sizes) {
+                auto const record = benchmark.run(r, benchmark.name + "/" + std::to_string(n), n);
+                auto const elapsed = std::chrono::duration<double, typename runner_t::duration_t::period>{detail::elapsed_of(record)};
+                result.points.emplace_back(n, elapsed.count());
+            }
+            result.fit = fit_complexity(result.points);
+        }
+        return results;
+    }
+
+private:
+    struct entry {
+        std::string name{};
+        std::vector<std::size_t> sizes{};
+        std::function<typename runner_t::record_t(runner_t &, std::string, std::size_t)> run{};
+    };
+
+    std::vector<entry> m_benchmarks{};
+};
+
+// One csv line per benchmark, the coefficient is in unit_of_measure
+template <report_sink Sink>
+void write_complexity(std::span<complexity_result const> results, Sink &sink) {
+    report_writer out{sink};
+    constexpr detail::record_layout layout{.non_finite = "nan"};
+    out.write("benchmark,complexity,coefficient,rms,unit_of_measure\n");
+    for (auto const &result : results) {
+        out.write(result.name);
+        out.write(',');
+        if (result.fit) {
+            out.write(to_string(result.fit->best));
+            out.write(',');
+            detail::write_field(out, result.fit->coefficient, layout);
+            out.write(',');
+            detail::write_field(out, result.fit->rms, layout);
+        } else {
+            out.write(",,");
+        }
+        out.write(',');
+        out.write(result.time_unit);
+        out.write('\n');
+    }
+}
+}  // namespace cpputils::benchmark
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef CPPUTILS_BENCHMARK_RUNNER_HPP
+#define CPPUTILS_BENCHMARK_RUNNER_HPP
+
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include "benchmark_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpputils::benchmark {
+
+// Keeps every sample of a section and summarizes them when reported
+template <duration D = default_duration>
+class sample_set {
+public:
+    using duration_t = D;
+
+    void record(D sample) {
+        m_samples.push_back(sample);
+        m_sorted = false;
+    }
+
+    void merge(sample_set const &other) {
+        m_samples.insert(m_samples.end(), other.m_samples.cbegin(), other.m_samples.cend());
+        m_sorted = m_samples.size() == other.m_samples.size() && other.m_sorted;
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept { return m_samples.size(); }
+
+    [[nodiscard]] D min() const { return percentile(0.0); }
+    [[nodiscard]] D max() const { return percentile(1.0); }
+    [[nodiscard]] D median() const { return percentile(0.5); }
+
+    // Nearest-rank percentile, q in [0, 1]
+    [[nodiscard]] D percentile(double q) const {
+        if (m_samples.empty()) { return D{}; }
+        sort();
+        auto const last = static_cast<double>(m_samples.size() - 1U);
+        auto const rank = static_cast<std::size_t>(std::ceil(std::clamp(q, 0.0, 1.0) * last));
+        return m_samples[rank];
+    }
+
+    [[nodiscard]] D mean() const {
+        return detail::duration_from_count<D>(mean_count());
+    }
+
+    // Sample standard deviation
+    [[nodiscard]] D stddev() const {
+        if (m_samples.size() < 2U) { return D{}; }
+        auto const avg = mean_count();
+        auto const squares = std::accumulate(m_samples.cbegin(), m_samples.cend(), 0.0, [avg](double acc, D sample) {
+            auto const diff = static_cast<double>(sample.count()) - avg;
+            return acc + diff * diff;
+        });
+        return detail::duration_from_count<D>(std::sqrt(squares / static_cast<double>(m_samples.size() - 1U)));
+    }
+
+    [[nodiscard]] D elapsed() const { return median(); }
+
+    [[nodiscard]] std::vector<D> const &samples() const noexcept { return m_samples; }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"samples"}, count());
+        f(std::string_view{"min"}, min());
+        f(std::string_view{"median"}, median());
+        f(std::string_view{"mean"}, mean());
+        f(std::string_view{"p90"}, percentile(0.9));  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        f(std::string_view{"p99"}, percentile(0.99));  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        f(std::string_view{"max"}, max());
+        f(std::string_view{"stddev"}, stddev());
+    }
+
+private:
+    // Sorting lazily keeps record() a plain push_back
+    mutable std::vector<D> m_samples{};
+    mutable bool m_sorted{true};
+
+    void sort() const {
+        if (!m_sorted) {
+            std::ranges::sort(m_samples);
+            m_sorted = true;
+        }
+    }
+
+    [[nodiscard]] double mean_count() const {
+        if (m_samples.empty()) { return 0.0; }
+        auto const sum = std::accumulate(m_samples.cbegin(), m_samples.cend(), 0.0, [](double acc, D sample) {
+            return acc + static_cast<double>(sample.count());
+        });
+        return sum / static_cast<double>(m_samples.size());
+    }
+};
+
+template <duration D = default_duration>
+using statistics_logger = std::unordered_map<std::string, sample_set<D>>;
+
+struct run_options {
+    // Calls executed before measuring anything, to warm up caches and branch predictors
+    std::size_t warmup_rounds{10};
+    // Number of samples recorded per section
+    std::size_t samples{50};
+    // Total time the measured calls should take, used to calibrate the iterations per sample
+    std::chrono::nanoseconds target_time{std::chrono::milliseconds{200}};
+    std::size_t max_iterations{1'000'000'000};
+    // Warm or cold runs are logged as "section/warm" or "section/cold". Cold runs time a single
+    // call per sample, right after the caches are flushed.
+    cache_mode cache{cache_mode::unlabelled};
+    // Size of the buffer used to flush the caches, 0 for twice the last level cache
+    std::size_t eviction_bytes{0};
+};
+
+// Times a callable repeatedly: after a warmup, the number of calls per sample is calibrated so that
+// all the samples take about run_options::target_time. Each sample records the mean time of a call.
+template <time_logger Logger = statistics_logger<>, time_counter TimeCounter = default_counter<>>
+requires time_record<typename Logger::mapped_type> && time_counter_compatible_delta<TimeCounter, Logger>
+class runner {
+public:
+    using logger_t = Logger;
+    using time_counter_t = TimeCounter;
+    using record_t = typename Logger::mapped_type;
+    using duration_t = typename record_t::duration_t;
+
+    runner()
+        : m_logger{get_static_logger<Logger>()} {}
+
+    explicit runner(Logger &logger, run_options options = {})
+        : m_logger{logger}
+        , m_options{options} {}
+
+    [[nodiscard]] run_options const &options() const noexcept { return m_options; }
+
+    Logger const &logger() const noexcept {
+        return m_logger;
+    }
+
+    // Replaces whatever was logged for the section before
+    record_t run(std::string msg, auto &&f, auto &&...args)
+        requires std::invocable<decltype(f) &, decltype(args) &...>
+    {
+        return run_with(std::move(msg), std::nullopt, f, args...);
+    }
+
+    // work is done by each call of f, it is logged if the record keeps it (see with_throughput)
+    record_t run(std::string msg, processed work, auto &&f, auto &&...args)
+        requires std::invocable<decltype(f) &, decltype(args) &...>
+    {
+        return run_with(std::move(msg), work, f, args...);
+    }
+
+private:
+    std::reference_wrapper<Logger> m_logger;
+    run_options m_options{};
+
+    record_t run_with(std::string msg, std::optional<processed> work, auto &f, auto &...args) {
+        for (std::size_t i = 0; i < m_options.warmup_rounds; ++i) {
+            detail::invoke_and_keep(f, args...);
+        }
+        auto const cold = m_options.cache == cache_mode::cold;
+        std::optional<cache_evictor> evictor{};
+        if (cold) { evictor.emplace(m_options.eviction_bytes); }
+        auto const iterations = cold ? std::size_t{1} : calibrate(f, args...);
+        record_t record{};
+        for (std::size_t i = 0; i < m_options.samples; ++i) {
+            if (evictor) {
+                evictor->evict();
+            } else if (m_options.cache == cache_mode::warm) {
+                detail::invoke_and_keep(f, args...);
+                (detail::touch_object(args), ...);
+            }
+            auto const sample = per_iteration(time_batch(iterations, f, args...), iterations);
+            if (work) {
+                detail::log_sample(record, detail::with_work<record_t>(sample, *work));
+            } else {
+                record.record(sample);
+            }
+        }
+        if (m_options.cache != cache_mode::unlabelled) {
+            msg += '/';
+            msg += to_string(m_options.cache);
+        }
+        m_logger.get()[std::move(msg)] = record;
+        return record;
+    }
+
+    [[nodiscard]] auto time_batch(std::size_t iterations, auto &f, auto &...args) const {
+        TimeCounter counter{};
+        counter.start();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            detail::invoke_and_keep(f, args...);
+        }
+        counter.stop();
+        return counter.delta();
+    }
+
+    [[nodiscard]] static duration_t per_iteration(duration auto elapsed, std::size_t iterations) {
+        auto const total = std::chrono::duration<double, typename duration_t::period>{elapsed};
+        return detail::duration_from_count<duration_t>(total.count() / static_cast<double>(iterations));
+    }
+
+    // Grow the batch until it is long enough to be measured reliably, then scale it to the target time
+    [[nodiscard]] std::size_t calibrate(auto &f, auto &...args) const {
+        using seconds = std::chrono::duration<double>;
+        auto const samples = std::max(m_options.samples, std::size_t{1});
+        auto const per_sample = seconds{m_options.target_time} / static_cast<double>(samples);
+        auto const measurable = per_sample / 10.0;  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        std::size_t iterations{1};
+        while (true) {
+            auto const elapsed = seconds{time_batch(iterations, f, args...)};
+            if (elapsed >= measurable || iterations >= m_options.max_iterations) {
+                auto const scale = elapsed.count() > 0.0 ? per_sample / elapsed : 1.0;
+                auto const max_iterations = static_cast<double>(std::max(m_options.max_iterations, std::size_t{1}));
+                return static_cast<std::size_t>(std::clamp(std::ceil(static_cast<double>(iterations) * scale), 1.0, max_iterations));
+            }
+            iterations = std::min(iterations * 10U, m_options.max_iterations);  // NOLINT(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        }
+    }
+};
+}  // namespace cpputils::benchmark
+
+#endif
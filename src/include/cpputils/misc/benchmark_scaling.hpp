@@ -0,0 +1,189 @@
+#ifndef CPPUTILS_BENCHMARK_SCALING_HPP
+#define CPPUTILS_BENCHMARK_SCALING_HPP
+
+#include "benchmark.hpp"
+#include "benchmark_concurrent.hpp"
+#include "benchmark_histogram.hpp"
+#include "system_macros.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <latch>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef CPPUTILS_LINUX_PLATFORM
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cpputils::benchmark {
+
+struct scaling_options {
+    std::size_t max_threads{std::max(std::thread::hardware_concurrency(), 1U)};
+    // Wall time of the run with each number of threads
+    std::chrono::nanoseconds duration{std::chrono::milliseconds{200}};
+    // Each thread is bound to a different core, as long as there are enough
+    bool pin_threads{true};
+};
+
+// Result of the run with a given number of threads
+struct scaling_point {
+    std::size_t threads{};
+    bool pinned{};
+    std::uint64_t calls{};
+    std::chrono::nanoseconds wall_time{};
+    // Calls per second of all the threads together
+    double throughput{};
+    // throughput / (threads * single thread throughput): 1 is perfect scaling
+    double efficiency{};
+};
+
+// 1, 2, 4, ... up to max_threads, which is always included
+[[nodiscard]] inline std::vector<std::size_t> thread_counts(std::size_t max_threads) {
+    std::vector<std::size_t> counts{};
+    for (std::size_t n = 1; n < max_threads; n *= 2U) { counts.push_back(n); }
+    counts.push_back(std::max(max_threads, std::size_t{1}));
+    return counts;
+}
+
+namespace detail {
+    // The cores the process may run on
+    [[nodiscard]] inline std::vector<std::size_t> available_cores() {
+        std::vector<std::size_t> cores{};
+#ifdef CPPUTILS_LINUX_PLATFORM
+        cpu_set_t set{};
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) { cores.push_back(cpu); }  // NOLINT
+            }
+        }
+#endif
+        return cores;
+    }
+
+    // False if pinning is not supported or not permitted
+    [[nodiscard]] inline bool pin_to_core([[maybe_unused]] std::size_t core) {
+#ifdef CPPUTILS_LINUX_PLATFORM
+        cpu_set_t set{};
+        CPU_SET(core, &set);  // NOLINT
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+}  // namespace detail
+
+// Runs a callable on 1, 2, 4, ... threads. The threads are released together and call f until the
+// run lasted scaling_options::duration. Every call is timed: thread i of the run with n threads
+// logs its latencies in section "name/n/i". f is shared by all the threads and is called with
+// the index of the thread if it accepts it.
+template <time_logger Logger = histogram_logger<>, time_counter TimeCounter = default_counter<>>
+requires section_logger<Logger> && std::default_initializable<Logger>
+class scaling_runner {
+public:
+    using logger_t = Logger;
+    using time_counter_t = TimeCounter;
+
+    explicit scaling_runner(Logger &logger, scaling_options options = {})
+        : m_logger{logger}
+        , m_options{options} {}
+
+    [[nodiscard]] scaling_options const &options() const noexcept { return m_options; }
+
+    template <typename F>
+    requires std::invocable<F &> || std::invocable<F &, std::size_t>
+    std::vector<scaling_point> run(std::string const &name, F &&f) {
+        std::vector<scaling_point> points{};
+        for (auto const threads : thread_counts(m_options.max_threads)) {
+            auto point = run_threads(name, threads, f);
+            auto const single_thread = points.empty() ? point.throughput : points.front().throughput;
+            point.efficiency = single_thread > 0.0 ? point.throughput / (static_cast<double>(threads) * single_thread) : 0.0;
+            points.push_back(point);
+        }
+        return points;
+    }
+
+private:
+    std::reference_wrapper<Logger> m_logger;
+    scaling_options m_options{};
+
+    // A cache line per thread, so that the driver adds no false sharing to the measure
+    struct alignas(detail::cache_line_size) thread_result {
+        Logger logger{};
+        std::uint64_t calls{};
+        bool pinned{};
+    };
+
+    scaling_point run_threads(std::string const &name, std::size_t threads, auto &f) {
+        auto const cores = m_options.pin_threads ? detail::available_cores() : std::vector<std::size_t>{};
+        std::vector<thread_result> results(threads);
+        std::atomic<bool> stop{false};
+        std::latch ready{static_cast<std::ptrdiff_t>(threads + 1U)};
+        std::vector<std::jthread> workers{};
+        workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([&, i] {
+                auto &result = results[i];
+                result.pinned = !cores.empty() && detail::pin_to_core(cores[i % cores.size()]);
+                typename timer<Logger, TimeCounter>::section section{result.logger, name + "/" + std::to_string(threads) + "/" + std::to_string(i)};
+                std::uint64_t calls{};
+                ready.arrive_and_wait();
+                while (!stop.load(std::memory_order_relaxed)) {
+                    typename timer<Logger, TimeCounter>::scoped const t{section};
+                    if constexpr (std::invocable<decltype(f), std::size_t>) {
+                        detail::invoke_and_keep(f, i);
+                    } else {
+                        detail::invoke_and_keep(f);
+                    }
+                    ++calls;
+                }
+                result.calls = calls;
+            });
+        }
+        ready.arrive_and_wait();
+        auto const start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(m_options.duration);
+        stop.store(true, std::memory_order_relaxed);
+        workers.clear();
+        auto const wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        scaling_point point{.threads = threads, .pinned = true, .wall_time = wall_time};
+        for (auto &result : results) {
+            point.calls += result.calls;
+            point.pinned = point.pinned && result.pinned;
+            for (auto &&[key, value] : result.logger) {
+                m_logger.get()[key] = value;
+            }
+        }
+        point.throughput = static_cast<double>(point.calls) / std::chrono::duration<double>{wall_time}.count();
+        return point;
+    }
+};
+
+// One csv line per number of threads, wall_time is in nanoseconds
+template <report_sink Sink>
+void write_scaling(std::span<scaling_point const> points, Sink &sink) {
+    report_writer out{sink};
+    out.write("threads,pinned,calls,wall_time,throughput,efficiency\n");
+    for (auto const &point : points) {
+        out.write_number(point.threads);
+        out.write(point.pinned ? ",true," : ",false,");
+        out.write_number(point.calls);
+        out.write(',');
+        out.write_number(point.wall_time);
+        out.write(',');
+        out.write_number(point.throughput);
+        out.write(',');
+        out.write_number(point.efficiency);
+        out.write('\n');
+    }
+}
+}  // namespace cpputils::benchmark
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef CPPUTILS_BENCHMARK_TRACE_HPP
+#define CPPUTILS_BENCHMARK_TRACE_HPP
+
+#include "../meta/traits.hpp"
+#include "benchmark.hpp"
+#include "benchmark_concurrent.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpputils::benchmark {
+
+namespace detail {
+    // "main;parse;lex" -> "lex"
+    [[nodiscard]] inline std::string_view innermost_section(std::string_view path) {
+        auto const separator = path.rfind(';');
+        return separator == std::string_view::npos ? path : path.substr(separator + 1U);
+    }
+}  // namespace detail
+
+// A closed section. path is the collapsed stack of the enclosing sections, e.g. "main;parse;lex".
+struct trace_event {
+    std::string path{};
+    std::size_t thread{};
+    std::size_t depth{};
+    // Since the creation of the logger
+    std::chrono::nanoseconds begin{};
+    std::chrono::nanoseconds duration{};
+    // duration minus the time spent in nested sections
+    std::chrono::nanoseconds self{};
+
+    [[nodiscard]] std::string_view name() const { return detail::innermost_section(path); }
+};
+
+// Aggregate of all the events with the same path
+class trace_record {
+public:
+    using duration_t = std::chrono::nanoseconds;
+
+    void record(duration_t elapsed) {
+        ++m_calls;
+        m_total += elapsed;
+        m_self += elapsed;
+    }
+
+    void record(trace_event const &event) {
+        ++m_calls;
+        m_total += event.duration;
+        m_self += event.self;
+    }
+
+    void merge(trace_record const &other) {
+        m_calls += other.m_calls;
+        m_total += other.m_total;
+        m_self += other.m_self;
+    }
+
+    [[nodiscard]] std::uint64_t calls() const noexcept { return m_calls; }
+    [[nodiscard]] duration_t total() const noexcept { return m_total; }
+    [[nodiscard]] duration_t self() const noexcept { return m_self; }
+    [[nodiscard]] duration_t elapsed() const noexcept { return m_total; }
+
+    void for_each_field(auto &&f) const {
+        f(std::string_view{"calls"}, calls());
+        f(std::string_view{"total"}, total());
+        f(std::string_view{"self"}, self());
+    }
+
+private:
+    std::uint64_t m_calls{};
+    duration_t m_total{};
+    duration_t m_self{};
+};
+
+namespace detail {
+    // A section still open
+    template <typename Clock>
+    struct trace_frame {
+        std::string path{};
+        typename Clock::time_point begin{};
+        std::chrono::nanoseconds children{};
+    };
+
+    template <typename Clock>
+    struct trace_buffer {
+        std::vector<trace_frame<Clock>> stack{};
+        std::vector<trace_event> events{};
+        std::unordered_map<std::string, trace_record> records{};
+    };
+}  // namespace detail
+
+// Tracks the nesting of the sections timed by each thread. Every closed section is kept as a
+// trace_event in the buffer of its thread, and aggregated by path: iterating the logger gives
+// one trace_record per path.
+// Sections must be closed in reverse order of opening (as scoped timers are).
+class trace_logger {
+    using clock_t = std::chrono::steady_clock;
+
+    using frame = detail::trace_frame<clock_t>;
+    using thread_data = detail::trace_buffer<clock_t>;
+    using buffer_t = detail::thread_buffer<thread_data>;
+
+public:
+    using key_type = std::string;
+    using mapped_type = trace_record;
+    using value_type = std::pair<std::string const, trace_record>;
+
+    class slot {
+    public:
+        slot(buffer_t &buffer, std::string key)
+            : m_buffer{buffer}
+            , m_key{std::move(key)} {}
+
+        slot &operator=(trace_record value) {  // NOLINT(cppcoreguidelines-c-copy-assignment-signature, misc-unconventional-assign-operator)
+            std::scoped_lock const lock{m_buffer.get()};
+            m_buffer.get().value.records[m_key] = value;
+            return *this;
+        }
+
+    private:
+        std::reference_wrapper<buffer_t> m_buffer;
+        std::string m_key;
+    };
+
+    trace_logger() = default;
+
+    trace_logger(trace_logger const &other)
+        : m_epoch{other.m_epoch} {
+        auto &data = m_buffers.add().value;
+        data.events = other.events();
+        for (auto &&[key, value] : other.snapshot()) {
+            data.records.emplace(key, value);
+        }
+    }
+
+    trace_logger(trace_logger &&other) noexcept
+        : m_epoch{other.m_epoch} {
+        swap(other);
+    }
+
+    trace_logger &operator=(trace_logger const &other) {
+        if (this != &other) { trace_logger{other}.swap(*this); }
+        return *this;
+    }
+
+    trace_logger &operator=(trace_logger &&other) noexcept {
+        trace_logger{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    ~trace_logger() = default;
+
+    void on_start(std::string const &name) {
+        auto &buffer = m_buffers.local();
+        std::scoped_lock const lock{buffer};
+        auto &stack = buffer.value.stack;
+        auto path = stack.empty() ? name : stack.back().path + ";" + name;
+        stack.push_back(frame{.path = std::move(path), .begin = clock_t::now()});
+    }
+
+    void record(std::string const &name, duration auto sample) {
+        auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(sample);
+        auto &buffer = m_buffers.local();
+        std::scoped_lock const lock{buffer};
+        auto &data = buffer.value;
+        auto event = trace_event{.path = name, .thread = buffer.index, .duration = elapsed, .self = elapsed};
+
+        auto const open = std::ranges::find_if(data.stack | std::views::reverse, [&name](frame const &f) {
+            return detail::innermost_section(f.path) == name;
+        });
+        if (open != std::ranges::rend(data.stack)) {
+            auto const depth = static_cast<std::size_t>(std::ranges::distance(open, std::ranges::rend(data.stack))) - 1U;
+            auto &closed = data.stack[depth];
+            event.path = std::move(closed.path);
+            event.depth = depth;
+            event.begin = closed.begin - m_epoch;
+            event.self = std::max(elapsed - closed.children, std::chrono::nanoseconds{});
+            // Sections opened inside this one and never closed are dropped
+            data.stack.resize(depth);
+            if (!data.stack.empty()) { data.stack.back().children += elapsed; }
+        } else {
+            event.begin = clock_t::now() - elapsed - m_epoch;
+        }
+        data.records[event.path].record(event);
+        data.events.push_back(std::move(event));
+    }
+
+    [[nodiscard]] slot operator[](std::string key) {
+        return slot{m_buffers.local(), std::move(key)};
+    }
+
+    // All the events, ordered by thread and start time
+    [[nodiscard]] std::vector<trace_event> events() const {
+        std::vector<trace_event> all{};
+        m_buffers.for_each([&all](buffer_t &buffer) {
+            std::scoped_lock const lock{buffer};
+            all.insert(all.end(), buffer.value.events.cbegin(), buffer.value.events.cend());
+        });
+        std::ranges::sort(all, {}, [](trace_event const &e) { return std::tie(e.thread, e.begin, e.depth); });
+        return all;
+    }
+
+    [[nodiscard]] std::unordered_map<std::string, trace_record> snapshot() const {
+        std::unordered_map<std::string, trace_record> merged{};
+        m_buffers.for_each([&merged](buffer_t &buffer) {
+            std::scoped_lock const lock{buffer};
+            for (auto const &[key, value] : buffer.value.records) {
+                merged[key].merge(value);
+            }
+        });
+        return merged;
+    }
+
+    [[nodiscard]] auto begin() {
+        m_snapshot = snapshot();
+        return m_snapshot.begin();
+    }
+
+    [[nodiscard]] auto end() {
+        return m_snapshot.end();
+    }
+
+    void swap(trace_logger &other) noexcept {
+        m_buffers.swap(other.m_buffers);
+        std::swap(m_epoch, other.m_epoch);
+        std::swap(m_snapshot, other.m_snapshot);
+    }
+
+private:
+    clock_t::time_point m_epoch{clock_t::now()};
+    detail::per_thread<buffer_t> m_buffers{};
+    std::unordered_map<std::string, trace_record> m_snapshot{};
+};
+
+namespace formatters {
+    // Chrome Trace Event format, can be loaded by Perfetto or chrome://tracing. Events are always
+    // written by thread and start time.
+    struct chrome_trace : detail::string_report<chrome_trace> {
+        [[nodiscard]] static std::string_view type() noexcept { return "chrome_trace"; }
+
+        template <time_logger Logger, report_sink Sink>
+        requires requires (Logger const logger) {
+                     { logger.events() } -> std::same_as<std::vector<trace_event>>;
+                 }
+        static void write(Logger const &logger, Sink &sink, [[maybe_unused]] report_order order) {
+            report_writer out{sink};
+            out.write("{\"traceEvents\": [");
+            bool first{true};
+            for (auto const &event : logger.events()) {
+                out.write(first ? "\n" : ",\n");
+                first = false;
+                out.write("  {\"name\": \"");
+                out.write(detail::json_escape(event.name()));
+                out.write("\", \"cat\": \"cpputils\", \"ph\": \"X\", \"ts\": ");
+                out.write_number(std::chrono::duration<double, std::micro>{event.begin});
+                out.write(", \"dur\": ");
+                out.write_number(std::chrono::duration<double, std::micro>{event.duration});
+                out.write(", \"pid\": 1, \"tid\": ");
+                out.write_number(event.thread);
+                out.write(", \"args\": {\"path\": \"");
+                out.write(detail::json_escape(event.path));
+                out.write("\"}}");
+            }
+            out.write("\n], \"displayTimeUnit\": \"ns\"}\n");
+        }
+    };
+
+    // One "path self_time" line per call stack, the input of flamegraph.pl and similar tools
+    struct collapsed_stacks : detail::string_report<collapsed_stacks> {
+        [[nodiscard]] static std::string_view type() noexcept { return "collapsed_stacks"; }
+
+        template <time_logger Logger, report_sink Sink>
+        requires std::same_as<typename Logger::mapped_type, trace_record>
+        static void write(Logger const &logger, Sink &sink, report_order order) {
+            report_writer out{sink};
+            detail::for_each_entry(logger, order, [&out](std::string const &path, trace_record const &record) {
+                out.write(path);
+                out.write(' ');
+                out.write_number(record.self());
+                out.write('\n');
+            });
+        }
+    };
+}  // namespace formatters
+}  // namespace cpputils::benchmark
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef CPPUTILS_BENCHMARK_TSC_HPP
+#define CPPUTILS_BENCHMARK_TSC_HPP
+
+#include "benchmark.hpp"
+#include "system_macros.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#ifdef CPPUTILS_X86_PLATFORM
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace cpputils::benchmark {
+
+namespace detail {
+    struct tsc_calibration {
+        bool usable{false};
+        double nanoseconds_per_cycle{};
+    };
+
+#ifdef CPPUTILS_X86_PLATFORM
+    // EDX of an extended CPUID leaf, 0 if the processor does not have it
+    [[nodiscard]] inline unsigned extended_cpuid_edx(unsigned leaf) {
+        std::array<unsigned, 4> regs{};
+#ifdef _MSC_VER
+        std::array<int, 4> info{};
+        __cpuid(info.data(), static_cast<int>(leaf & 0x80000000U));
+        if (static_cast<unsigned>(info[0]) < leaf) { return 0U; }
+        __cpuid(info.data(), static_cast<int>(leaf));
+        std::ranges::transform(info, regs.begin(), [](int r) { return static_cast<unsigned>(r); });
+#else
+        if (__get_cpuid_max(leaf & 0x80000000U, nullptr) < leaf) { return 0U; }
+        __get_cpuid(leaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+        return regs[3];
+    }
+
+    // CPUID.80000007H:EDX[8], the TSC ticks at a constant rate in every power state
+    [[nodiscard]] inline bool has_invariant_tsc() {
+        constexpr unsigned power_management_leaf = 0x80000007U;
+        constexpr unsigned invariant_tsc_bit = 1U << 8U;
+        return (extended_cpuid_edx(power_management_leaf) & invariant_tsc_bit) != 0U;
+    }
+
+    // CPUID.80000001H:EDX[27], without it rdtscp is an invalid instruction
+    [[nodiscard]] inline bool has_rdtscp() {
+        constexpr unsigned features_leaf = 0x80000001U;
+        constexpr unsigned rdtscp_bit = 1U << 27U;
+        return (extended_cpuid_edx(features_leaf) & rdtscp_bit) != 0U;
+    }
+
+    // lfence keeps rdtsc from being executed before the preceding instructions
+    [[nodiscard]] inline std::uint64_t tsc_start() noexcept {
+        _mm_lfence();
+        auto const cycles = __rdtsc();
+        _mm_lfence();
+        return cycles;
+    }
+
+    // rdtscp waits for the measured instructions, lfence keeps the following ones from starting earlier
+    [[nodiscard]] inline std::uint64_t tsc_stop() noexcept {
+        unsigned aux{};
+        auto const cycles = __rdtscp(&aux);
+        _mm_lfence();
+        return cycles;
+    }
+
+    // The rate is measured a few times against the steady clock: if the measures disagree the TSC is
+    // not considered reliable
+    [[nodiscard]] inline tsc_calibration calibrate_tsc() {
+        if (!has_invariant_tsc() || !has_rdtscp()) { return {}; }
+        constexpr std::size_t rounds = 3;
+        constexpr auto round_time = std::chrono::milliseconds{10};
+        constexpr double max_relative_spread = 0.01;
+        std::array<double, rounds> rates{};
+        for (auto &rate : rates) {
+            auto const clock_start = std::chrono::steady_clock::now();
+            auto const cycles_start = tsc_start();
+            auto clock_stop = clock_start;
+            while (clock_stop - clock_start < round_time) {
+                clock_stop = std::chrono::steady_clock::now();
+            }
+            auto const cycles_stop = tsc_stop();
+            if (cycles_stop <= cycles_start) { return {}; }
+            auto const elapsed = std::chrono::duration<double, std::nano>{clock_stop - clock_start};
+            rate = elapsed.count() / static_cast<double>(cycles_stop - cycles_start);
+        }
+        auto const [min, max] = std::ranges::minmax(rates);
+        if ((max - min) / min > max_relative_spread) { return {}; }
+        std::ranges::sort(rates);
+        return {.usable = true, .nanoseconds_per_cycle = rates[rounds / 2]};
+    }
+#else
+    [[nodiscard]] inline std::uint64_t tsc_start() noexcept { return 0U; }
+    [[nodiscard]] inline std::uint64_t tsc_stop() noexcept { return 0U; }
+    [[nodiscard]] inline tsc_calibration calibrate_tsc() { return {}; }
+#endif
+
+    [[nodiscard]] inline tsc_calibration const &tsc_info() {
+        static tsc_calibration const calibration = calibrate_tsc();
+        return calibration;
+    }
+}  // namespace detail
+
+// Reads the time stamp counter of x86 processors, which has a much finer resolution and cost
+// than a clock reading. The counter is calibrated the first time it is used (or when calibrate()
+// is called), if the TSC is not invariant, not stable or rdtscp is missing Clock is used instead.
+template <typename Clock = default_clock>
+class tsc_counter {
+public:
+    using clock_t = Clock;
+
+    tsc_counter()
+        : m_calibration{detail::tsc_info()} {}
+
+    // Call it at startup to keep the calibration out of the measures
+    static void calibrate() {
+        [[maybe_unused]] auto const &calibration = detail::tsc_info();
+    }
+
+    [[nodiscard]] static bool uses_tsc() { return detail::tsc_info().usable; }
+
+    [[nodiscard]] static double nanoseconds_per_cycle() { return detail::tsc_info().nanoseconds_per_cycle; }
+
+    void start() {
+        if (m_calibration.usable) {
+            m_start_cycles = detail::tsc_start();
+        } else {
+            m_start = Clock::now();
+        }
+    }
+
+    void stop() {
+        if (m_calibration.usable) {
+            m_stop_cycles = detail::tsc_stop();
+        } else {
+            m_stop = Clock::now();
+        }
+    }
+
+    [[nodiscard]] std::uint64_t cycles() const {
+        return m_stop_cycles - m_start_cycles;
+    }
+
+    [[nodiscard]] std::chrono::nanoseconds delta() const {
+        if (m_calibration.usable) {
+            auto const nanoseconds = std::llround(static_cast<double>(cycles()) * m_calibration.nanoseconds_per_cycle);
+            return std::chrono::nanoseconds{nanoseconds};
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(m_stop - m_start);
+    }
+
+private:
+    detail::tsc_calibration m_calibration;
+    std::uint64_t m_start_cycles{};
+    std::uint64_t m_stop_cycles{};
+    std::chrono::time_point<Clock> m_start{};
+    std::chrono::time_point<Clock> m_stop{};
+};
+}  // namespace cpputils::benchmark
+
+#endif
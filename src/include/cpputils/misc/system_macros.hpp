@@ -5,4 +5,16 @@
 #define CPPUTILS_WINDOWS_PLATFORM
 #endif
 
-#endif
\ No newline at end of file
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CPPUTILS_X86_PLATFORM
+#endif
+
+#if defined(__linux__)
+#define CPPUTILS_LINUX_PLATFORM
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPPUTILS_POSIX_PLATFORM
+#endif
+
+#endif
@@ -1,3 +1,6 @@
+#ifndef CPPUTILS_STATIC_STRING_HPP
+#define CPPUTILS_STATIC_STRING_HPP
+
 #include <algorithm>
 #include <cstddef>
 #include <string_view>
@@ -23,3 +26,5 @@ struct static_string {
 template <std::size_t N>
 static_string(char const (&)[N]) -> static_string<N - 1>;  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
 }  // namespace cpputils
+
+#endif
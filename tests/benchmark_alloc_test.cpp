@@ -0,0 +1,121 @@
+#include "cpputils/misc/benchmark_alloc.hpp"
+#include "cpputils/misc/benchmark_alloc_hooks.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+static_assert(time_counter<alloc_counter<>>);
+static_assert(time_record<alloc_record<>>);
+
+namespace {
+struct alignas(64) over_aligned {
+    std::uint64_t value{};
+};
+}  // namespace
+
+TEST_CASE("alloc-counter-measurement", "[benchmark-alloc]") {
+    REQUIRE(allocation_tracking_enabled());
+    alloc_counter<> counter{};
+    counter.start();
+    {
+        std::vector<std::int32_t> v{};
+        v.reserve(1000U);
+        auto const p = std::make_unique<std::uint64_t>(1U);
+        do_not_optimize(v);
+        do_not_optimize(p);
+    }
+    counter.stop();
+    auto const measurement = counter.measurement();
+    REQUIRE(measurement.tracked);
+    REQUIRE(measurement.elapsed == counter.delta());
+    REQUIRE(measurement.allocations == 2U);
+    REQUIRE(measurement.bytes == 4000U + sizeof(std::uint64_t));
+    REQUIRE(measurement.peak_bytes == 4000U + sizeof(std::uint64_t));
+}
+
+TEST_CASE("alloc-counter-peak", "[benchmark-alloc]") {
+    alloc_counter<> outer{};
+    alloc_counter<> inner{};
+    std::vector<std::int32_t> kept{};
+    outer.start();
+    {
+        std::vector<std::int32_t> const a(100U);
+    }
+    inner.start();
+    {
+        std::vector<std::int32_t> const b(50U);
+    }
+    inner.stop();
+    kept.resize(10U);
+    outer.stop();
+    REQUIRE(inner.measurement().peak_bytes == 200U);
+    REQUIRE(outer.measurement().allocations == 3U);
+    REQUIRE(outer.measurement().bytes == 640U);
+    REQUIRE(outer.measurement().peak_bytes == 400U);
+}
+
+TEST_CASE("alloc-hooks-alignment", "[benchmark-alloc]") {
+    alloc_counter<> counter{};
+    counter.start();
+    {
+        auto const p = std::make_unique<over_aligned>();
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p.get()) % alignof(over_aligned) == 0U);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto *q = new (std::nothrow) std::uint64_t[4];  // NOLINT(cppcoreguidelines-owning-memory)
+        REQUIRE(q != nullptr);
+        do_not_optimize(q);
+        delete[] q;  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+    counter.stop();
+    REQUIRE(counter.measurement().allocations == 2U);
+    REQUIRE(counter.measurement().bytes == sizeof(over_aligned) + 4U * sizeof(std::uint64_t));
+}
+
+TEST_CASE("alloc-record-with-timer", "[benchmark-alloc]") {
+    auto logger = alloc_logger<>{};
+    for (int i = 0; i < 4; ++i) {
+        timer<alloc_logger<>, alloc_counter<>>::scoped const t{logger, "section"};
+        std::vector<std::int32_t> const v(static_cast<std::size_t>(i + 1) * 10U);
+    }
+    auto const &record = logger.at("section");
+    REQUIRE(record.count() == 4U);
+    REQUIRE(record.allocations() == Catch::Approx(1.0));
+    REQUIRE(record.bytes() == Catch::Approx(100.0));
+    REQUIRE(record.peak_bytes() == Catch::Approx(160.0));
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,samples,elapsed,allocations,bytes,peak_bytes,unit_of_measure\n"));
+}
+
+TEST_CASE("alloc-record-elapsed-only", "[benchmark-alloc]") {
+    auto logger = alloc_logger<>{};
+    {
+        timer<alloc_logger<>>::scoped const t{logger, "section"};
+    }
+    auto const &record = logger.at("section");
+    REQUIRE(record.count() == 1U);
+    REQUIRE(std::isnan(record.allocations()));
+    REQUIRE(std::isnan(record.peak_bytes()));
+}
+
+TEST_CASE("alloc-record-merge", "[benchmark-alloc]") {
+    alloc_record<std::chrono::nanoseconds> record{};
+    record.record(alloc_measurement<std::chrono::nanoseconds>{.elapsed = 10ns, .allocations = 2U, .bytes = 64U, .peak_bytes = 64U, .tracked = true});
+    alloc_record<std::chrono::nanoseconds> other{};
+    other.record(alloc_measurement<std::chrono::nanoseconds>{.elapsed = 30ns, .allocations = 4U, .bytes = 32U, .peak_bytes = 16U, .tracked = true});
+    record.merge(other);
+    REQUIRE(record.count() == 2U);
+    REQUIRE(record.elapsed() == 20ns);
+    REQUIRE(record.allocations() == Catch::Approx(3.0));
+    REQUIRE(record.bytes() == Catch::Approx(48.0));
+    REQUIRE(record.peak_bytes() == Catch::Approx(64.0));
+}
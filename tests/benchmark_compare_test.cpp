@@ -0,0 +1,159 @@
+#include "cpputils/misc/benchmark_compare.hpp"
+#include "cpputils/misc/benchmark_runner.hpp"
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+namespace {
+section_result section_with(std::string name, double center, double spread = 1.0) {
+    section_result section{.name = std::move(name), .elapsed = center};
+    for (int i = 0; i < 30; ++i) {
+        section.samples.push_back(center + spread * static_cast<double>(i % 7 - 3));
+    }
+    return section;
+}
+}  // namespace
+
+TEST_CASE("json-formatter-is-valid-json", "[benchmark-compare]") {
+    auto logger = std::unordered_map<std::string, std::chrono::nanoseconds>{{"quoted \"section\"", 10ns}};
+    auto const json = reporter<>::report<formatters::json>(logger);
+    REQUIRE(json.find("\"time_unit\": \"nanoseconds\"") != std::string::npos);
+    REQUIRE(json.find("        \"quoted \\\"section\\\"\": 10\n") != std::string::npos);
+
+    auto stats = statistics_logger<std::chrono::nanoseconds>{};
+    stats["section"].record(5ns);
+    auto const records = reporter<>::report<formatters::json>(stats);
+    REQUIRE(records.find("\"section\": {\"samples\": 1, \"min\": 5, ") != std::string::npos);
+}
+
+TEST_CASE("json-formatter-nests-sections", "[benchmark-compare]") {
+    auto const parses = [](std::string const &json) {
+        cpputils::benchmark::detail::json_reader reader{json};
+        return reader.skip() && reader.at_end();
+    };
+    auto logger = std::unordered_map<std::string, std::chrono::nanoseconds>{};
+    REQUIRE(parses(reporter<>::report<formatters::json>(logger)));
+
+    // Sections named like the metadata are not duplicate keys
+    logger["time_unit"] = 1ns;
+    logger["utc_time"] = 2ns;
+    auto const json = reporter<>::report<formatters::json>(logger);
+    REQUIRE(parses(json));
+    std::vector<std::string> sections{};
+    cpputils::benchmark::detail::json_reader reader{json};
+    REQUIRE(reader.object([&](std::string const &key) {
+        if (key != "sections") { return reader.skip(); }
+        return reader.object([&](std::string const &name) {
+            sections.push_back(name);
+            return reader.skip();
+        });
+    }));
+    std::ranges::sort(sections);
+    REQUIRE(sections == std::vector<std::string>{"time_unit", "utc_time"});
+}
+
+TEST_CASE("results-round-trip", "[benchmark-compare]") {
+    auto logger = statistics_logger<std::chrono::nanoseconds>{};
+    for (auto i = 1; i <= 5; ++i) {
+        logger["b\\section"].record(std::chrono::nanoseconds{i});
+        logger["a"].record(std::chrono::nanoseconds{i * 10});
+    }
+    using results_reporter = reporter<formatters::json_results>;
+    auto const json = results_reporter::report<formatters::json_results>(logger);
+    REQUIRE(json.starts_with("{\"schema\": \"cpputils.benchmark.results\", \"version\": 1, \"time_unit\": \"nanoseconds\""));
+
+    auto const parsed = parse_results(json);
+    REQUIRE(parsed.has_value());
+    auto const collected = collect_results(logger);
+    REQUIRE(parsed->time_unit == collected.time_unit);
+    REQUIRE(parsed->sections.size() == 2U);
+    for (auto const &section : collected.sections) {
+        auto const *const read = parsed->find(section.name);
+        REQUIRE(read != nullptr);
+        REQUIRE(read->elapsed == Catch::Approx(section.elapsed));
+        REQUIRE(read->fields == section.fields);
+        REQUIRE(read->samples == section.samples);
+    }
+    REQUIRE(collected.sections.front().name == "a");
+    REQUIRE(parsed->find("b\\section")->samples == std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0});
+}
+
+TEST_CASE("results-keep-samples-of-wrapped-records", "[benchmark-compare]") {
+    auto logger = throughput_logger<sample_set<std::chrono::nanoseconds>>{};
+    for (auto i = 1; i <= 3; ++i) {
+        logger["section"].record(processed_sample<std::chrono::nanoseconds>{.sample = std::chrono::nanoseconds{i}, .work = {.items = 4U}});
+    }
+    auto const collected = collect_results(logger);
+    REQUIRE(collected.sections.front().samples == std::vector<double>{1.0, 2.0, 3.0});
+}
+
+TEST_CASE("results-parsing-is-strict-about-schema", "[benchmark-compare]") {
+    REQUIRE_FALSE(parse_results("").has_value());
+    REQUIRE_FALSE(parse_results("{\"schema\": \"other\", \"version\": 1, \"sections\": []}").has_value());
+    REQUIRE_FALSE(parse_results("{\"schema\": \"cpputils.benchmark.results\", \"version\": 2, \"sections\": []}").has_value());
+    REQUIRE_FALSE(parse_results("{\"schema\": \"cpputils.benchmark.results\", \"version\": 1, \"sections\": [}").has_value());
+    for (auto const *const value : {"inf", "-inf", "nan", "infinity"}) {
+        REQUIRE_FALSE(parse_results(std::string{"{\"schema\": \"cpputils.benchmark.results\", \"version\": 1, \"sections\": [{\"name\": \"a\", \"elapsed\": "} + value + "}]}").has_value());
+    }
+
+    auto const newer = parse_results(
+        "{\"schema\": \"cpputils.benchmark.results\", \"version\": 1, \"time_unit\": \"microseconds\", \"extra\": {\"a\": [true, null]},"
+        " \"sections\": [{\"name\": \"caf\\u00e9\", \"elapsed\": null, \"fields\": {}, \"samples\": [], \"new\": \"x\"}]}");
+    REQUIRE(newer.has_value());
+    REQUIRE(newer->time_unit == "microseconds");
+    REQUIRE(newer->sections.front().name == "caf\xc3\xa9");
+    REQUIRE(std::isnan(newer->sections.front().elapsed));
+}
+
+TEST_CASE("compare-detects-regressions", "[benchmark-compare]") {
+    run_results const baseline{.time_unit = "nanoseconds",
+                               .sections = {section_with("same", 100.0), section_with("slower", 100.0), section_with("faster", 100.0), section_with("removed", 1.0)}};
+    run_results const candidate{.time_unit = "microseconds",
+                                .sections = {section_with("same", 0.1, 0.001), section_with("slower", 0.12, 0.001), section_with("faster", 0.08, 0.001), section_with("added", 1.0)}};
+
+    auto const result = compare(baseline, candidate);
+    REQUIRE(result.has_regressions());
+    REQUIRE(result.sections.size() == 3U);
+    REQUIRE(result.only_in_baseline == std::vector<std::string>{"removed"});
+    REQUIRE(result.only_in_candidate == std::vector<std::string>{"added"});
+
+    auto const &same = result.sections[0];
+    REQUIRE(same.result == verdict::unchanged);
+    REQUIRE(same.relative_delta == Catch::Approx(0.0).margin(1e-9));
+    REQUIRE(same.p_value > 0.05);
+
+    auto const &slower = result.sections[1];
+    REQUIRE(slower.result == verdict::regressed);
+    REQUIRE(slower.candidate == Catch::Approx(120.0));
+    REQUIRE(slower.relative_delta == Catch::Approx(0.2));
+    REQUIRE(slower.ci_low > 0.1);
+    REQUIRE(slower.ci_high < 0.3);
+    REQUIRE(slower.p_value < 0.05);
+
+    REQUIRE(result.sections[2].result == verdict::improved);
+
+    std::string csv{};
+    string_sink sink{csv};
+    write_comparison(result, sink);
+    REQUIRE(csv.starts_with("section,baseline,candidate,relative_delta,ci_low,ci_high,p_value,verdict,unit_of_measure\n"));
+    REQUIRE(csv.find(",regressed,nanoseconds\n") != std::string::npos);
+    REQUIRE(csv.find("removed,,,,,,,removed,nanoseconds\n") != std::string::npos);
+}
+
+TEST_CASE("compare-single-samples", "[benchmark-compare]") {
+    auto const baseline = collect_results(std::unordered_map<std::string, std::chrono::nanoseconds>{{"section", 100ns}});
+    auto const candidate = collect_results(std::unordered_map<std::string, std::chrono::nanoseconds>{{"section", 103ns}});
+    auto const result = compare(baseline, candidate, {.threshold = 0.02});
+    REQUIRE(result.sections.front().result == verdict::regressed);
+    REQUIRE(std::isnan(result.sections.front().p_value));
+    REQUIRE_FALSE(compare(baseline, candidate).has_regressions());
+}
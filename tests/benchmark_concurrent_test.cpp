@@ -0,0 +1,115 @@
+#include "cpputils/misc/benchmark_concurrent.hpp"
+#include "cpputils/misc/benchmark_histogram.hpp"
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+namespace {
+void run_on_threads(std::size_t num_threads, auto const &f) {
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(f, i);
+    }
+    for (auto &t : threads) { t.join(); }
+}
+}  // namespace
+
+TEST_CASE("concurrent-logger-merges-records", "[benchmark-concurrent]") {
+    using logger_t = concurrent_logger<histogram_logger<>>;
+    auto logger = logger_t{};
+    run_on_threads(8U, [&logger](std::size_t) {
+        for (int i = 0; i < 1000; ++i) {
+            timer<logger_t>::scoped const t{logger, "section"};
+        }
+    });
+    auto const merged = logger.snapshot();
+    REQUIRE(merged.size() == 1U);
+    REQUIRE(merged.at("section").count() == 8000U);
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.find("section,8000,") != std::string::npos);
+}
+
+TEST_CASE("concurrent-logger-plain-durations", "[benchmark-concurrent]") {
+    auto logger = concurrent_logger<>{};
+    run_on_threads(4U, [&logger](std::size_t i) {
+        timer<concurrent_logger<>>::scoped const t{logger, "thread_" + std::to_string(i)};
+    });
+    std::size_t sections{};
+    for ([[maybe_unused]] auto const &kv : logger) { ++sections; }
+    REQUIRE(sections == 4U);
+}
+
+TEST_CASE("concurrent-logger-copy-and-move", "[benchmark-concurrent]") {
+    auto logger = concurrent_logger<>{};
+    logger["a"] = default_duration{1};
+    logger["b"] = default_duration{2};
+
+    auto copied = logger;
+    copied["c"] = default_duration{3};
+    REQUIRE(copied.snapshot().size() == 3U);
+    REQUIRE(logger.snapshot().size() == 2U);
+
+    auto moved = std::move(copied);
+    moved["d"] = default_duration{4};
+    REQUIRE(moved.snapshot().size() == 4U);
+    REQUIRE(moved.snapshot().at("a") == default_duration{1});
+}
+
+TEST_CASE("concurrent-logger-sections", "[benchmark-concurrent]") {
+    using logger_t = concurrent_logger<histogram_logger<>>;
+    auto logger = logger_t{};
+    run_on_threads(4U, [&logger](std::size_t) {
+        auto section = timer<logger_t>::section{logger, "section"};
+        for (int i = 0; i < 100; ++i) {
+            timer<logger_t>::scoped const t{section};
+        }
+    });
+    REQUIRE(logger.snapshot().at("section").count() == 400U);
+}
+
+TEST_CASE("concurrent-logger-short-lived", "[benchmark-concurrent]") {
+    auto const outer = concurrent_logger<>{};
+    for (int i = 0; i < 1000; ++i) {
+        auto logger = concurrent_logger<>{};
+        logger["section"] = default_duration{i};
+        REQUIRE(logger.snapshot().size() == 1U);
+        REQUIRE(logger.snapshot().at("section") == default_duration{i});
+    }
+    REQUIRE(outer.snapshot().empty());
+}
+
+TEST_CASE("concurrent-logger-snapshot-while-recording", "[benchmark-concurrent]") {
+    using logger_t = concurrent_logger<histogram_logger<>>;
+    auto logger = logger_t{};
+    std::atomic<std::size_t> running{4U};
+    std::vector<std::thread> threads{};
+    for (std::size_t i = 0; i < 4U; ++i) {
+        threads.emplace_back([&logger, &running] {
+            auto section = timer<logger_t>::section{logger, "section"};
+            for (int j = 0; j < 10000; ++j) {
+                timer<logger_t>::scoped const t{section};
+            }
+            logger.record("other", default_duration{1});
+            running.fetch_sub(1U);
+        });
+    }
+    std::size_t previous{};
+    while (running.load() != 0U) {
+        auto const snapshot = logger.snapshot();
+        if (auto const found = snapshot.find("section"); found != snapshot.end()) {
+            REQUIRE(found->second.count() >= previous);
+            previous = found->second.count();
+        }
+    }
+    for (auto &t : threads) { t.join(); }
+    auto const merged = logger.snapshot();
+    REQUIRE(merged.at("section").count() == 40000U);
+    REQUIRE(merged.at("other").count() == 4U);
+}
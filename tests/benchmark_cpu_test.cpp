@@ -0,0 +1,92 @@
+#include "cpputils/misc/benchmark_cpu.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+static_assert(time_counter<cpu_counter<>>);
+static_assert(time_record<cpu_record<>>);
+
+namespace {
+std::uint64_t spin_for(std::chrono::milliseconds duration) {
+    std::uint64_t iterations{};
+    auto const end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        ++iterations;
+        do_not_optimize(iterations);
+    }
+    return iterations;
+}
+}  // namespace
+
+TEST_CASE("cpu-counter-sleep-and-spin", "[benchmark-cpu]") {
+    cpu_counter<> sleeping{};
+    sleeping.start();
+    std::this_thread::sleep_for(20ms);
+    sleeping.stop();
+    auto const slept = sleeping.measurement();
+    REQUIRE(slept.elapsed == sleeping.delta());
+    REQUIRE(slept.elapsed >= 20ms);
+    if (slept.cpu_time_available) {
+        REQUIRE(slept.cpu_time < slept.elapsed / 2);
+    }
+    if (slept.switches_available) {
+        REQUIRE(slept.voluntary_switches >= 1U);
+    }
+
+    cpu_counter<> spinning{};
+    spinning.start();
+    spin_for(20ms);
+    spinning.stop();
+    auto const spun = spinning.measurement();
+    if (spun.cpu_time_available) {
+        REQUIRE(spun.cpu_time > 0ns);
+        REQUIRE(spun.cpu_time <= spun.elapsed + 1ms);
+    }
+}
+
+TEST_CASE("cpu-record-with-timer", "[benchmark-cpu]") {
+    auto logger = cpu_logger<>{};
+    for (int i = 0; i < 2; ++i) {
+        timer<cpu_logger<>, cpu_counter<>>::scoped const t{logger, "section"};
+        std::this_thread::sleep_for(5ms);
+    }
+    auto const &record = logger.at("section");
+    REQUIRE(record.count() == 2U);
+    auto const available = detail::thread_cpu_usage();
+    REQUIRE(std::isnan(record.cpu_utilization()) == !available.cpu_time_available);
+    REQUIRE(std::isnan(record.voluntary_switches()) == !available.switches_available);
+    if (available.cpu_time_available) {
+        REQUIRE(record.cpu_utilization() < 0.5);
+    }
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,samples,elapsed,cpu_time,cpu_utilization,voluntary_switches,involuntary_switches,unit_of_measure\n"));
+}
+
+TEST_CASE("cpu-record-merge", "[benchmark-cpu]") {
+    cpu_record<std::chrono::nanoseconds> record{};
+    record.record(cpu_measurement<std::chrono::nanoseconds>{.elapsed = 100ns, .cpu_time = 50ns, .voluntary_switches = 2U, .cpu_time_available = true, .switches_available = true});
+    cpu_record<std::chrono::nanoseconds> other{};
+    other.record(cpu_measurement<std::chrono::nanoseconds>{.elapsed = 300ns, .cpu_time = 150ns, .involuntary_switches = 4U, .cpu_time_available = true, .switches_available = true});
+    other.record(100ns);
+    record.merge(other);
+    REQUIRE(record.count() == 3U);
+    REQUIRE(record.elapsed() == 167ns);
+    REQUIRE(record.cpu_time() == Catch::Approx(100.0));
+    REQUIRE(record.cpu_utilization() == Catch::Approx(0.5));
+    REQUIRE(record.voluntary_switches() == Catch::Approx(1.0));
+    REQUIRE(record.involuntary_switches() == Catch::Approx(2.0));
+
+    cpu_record<std::chrono::nanoseconds> elapsed_only{};
+    elapsed_only.record(10ns);
+    REQUIRE(std::isnan(elapsed_only.cpu_time()));
+    REQUIRE(std::isnan(elapsed_only.voluntary_switches()));
+}
@@ -0,0 +1,81 @@
+#include "cpputils/misc/benchmark_histogram.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+TEST_CASE("histogram-small-values-are-exact", "[benchmark-histogram]") {
+    histogram<std::chrono::nanoseconds> h{};
+    for (auto i = 1; i <= 100; ++i) {
+        h.record(std::chrono::nanoseconds{i});
+    }
+    REQUIRE(h.count() == 100U);
+    REQUIRE(h.sum() == 5050ns);
+    REQUIRE(h.min() == 1ns);
+    REQUIRE(h.max() == 100ns);
+    REQUIRE(h.median() == 50ns);
+    REQUIRE(h.percentile(0.9) == 90ns);
+    REQUIRE(h.percentile(0.99) == 99ns);
+    REQUIRE(h.mean() == 51ns);
+}
+
+TEST_CASE("histogram-large-values-are-approximated", "[benchmark-histogram]") {
+    histogram<std::chrono::nanoseconds> h{};
+    for (auto i = 1; i <= 100'000; ++i) {
+        h.record(std::chrono::nanoseconds{i * 1'000});
+    }
+    auto const within = [](std::chrono::nanoseconds value, std::chrono::nanoseconds expected) {
+        auto const error = std::abs(static_cast<double>((value - expected).count())) / static_cast<double>(expected.count());
+        return error < 1.0 / 64.0;
+    };
+    REQUIRE(h.count() == 100'000U);
+    REQUIRE(h.min() == 1us);
+    REQUIRE(h.max() == 100ms);
+    REQUIRE(within(h.median(), 50ms));
+    REQUIRE(within(h.percentile(0.99), 99ms));
+    REQUIRE(within(h.percentile(0.999), 99'900us));
+}
+
+TEST_CASE("histogram-constant-memory", "[benchmark-histogram]") {
+    // Buckets are a fixed array covering every 64 bits value: less than 4k counters at the default precision
+    static_assert(sizeof(histogram<>) <= 4096U * sizeof(std::uint64_t));
+    histogram<std::chrono::nanoseconds> h{};
+    for (auto i = 0; i < 63; ++i) {
+        h.record(std::chrono::nanoseconds{std::int64_t{1} << i});
+    }
+    h.record(std::chrono::nanoseconds::max());
+    REQUIRE(h.count() == 64U);
+    REQUIRE(h.min() == 1ns);
+    REQUIRE(h.max() == std::chrono::nanoseconds::max());
+}
+
+TEST_CASE("histogram-merge", "[benchmark-histogram]") {
+    histogram<std::chrono::nanoseconds> lhs{};
+    histogram<std::chrono::nanoseconds> rhs{};
+    lhs.record(10ns);
+    rhs.record(2ns);
+    rhs.record(30ns);
+    lhs.merge(rhs);
+    REQUIRE(lhs.count() == 3U);
+    REQUIRE(lhs.min() == 2ns);
+    REQUIRE(lhs.max() == 30ns);
+    REQUIRE(lhs.median() == 10ns);
+}
+
+TEST_CASE("histogram-logger-with-timer", "[benchmark-histogram]") {
+    auto logger = histogram_logger<>{};
+    for (int i = 0; i < 5; ++i) {
+        timer<histogram_logger<>>::scoped const t{logger, "section"};
+    }
+    REQUIRE(logger.at("section").count() == 5U);
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,count,sum,min,mean,p50,p90,p99,p999,max,unit_of_measure\n"));
+    REQUIRE(csv.find("section,5,") != std::string::npos);
+}
@@ -0,0 +1,59 @@
+#include "cpputils/misc/benchmark_load.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+static_assert(time_record<load_record<>>);
+
+TEST_CASE("load-generator-rates", "[benchmark-load]") {
+    auto logger = load_logger<std::chrono::nanoseconds>{};
+    auto generator = load_generator<std::chrono::nanoseconds>{logger, load_options{.rates = {0.0, 500.0, 2000.0}, .duration = 50ms}};
+    std::uint64_t calls{};
+    auto const records = generator.run("noop", [&calls] { ++calls; });
+
+    REQUIRE(records.size() == 2U);
+    REQUIRE(calls == 25U + 100U);
+    REQUIRE(logger.size() == 2U);
+    auto const &slow = logger.at("noop/500");
+    REQUIRE(slow.target_rate() == Catch::Approx(500.0));
+    REQUIRE(slow.latency().count() == 25U);
+    REQUIRE(slow.achieved_rate() > 0.0);
+    REQUIRE(slow.achieved_rate() <= 500.0 * 25.0 / 24.0 + 1.0);
+    REQUIRE(logger.at("noop/2000").latency().count() == 100U);
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,target_rate,achieved_rate,count,sum,min,mean,p50,p90,p99,p999,max,service_p50,service_p99,unit_of_measure\n"));
+}
+
+TEST_CASE("load-generator-fractional-rates", "[benchmark-load]") {
+    auto logger = load_logger<std::chrono::nanoseconds>{};
+    // A single call each, fired at the start of the run
+    auto generator = load_generator<std::chrono::nanoseconds>{logger, load_options{.rates = {0.25, 0.4, 2.5}, .duration = 10ms}};
+    static_cast<void>(generator.run("noop", [] {}));
+    REQUIRE(logger.size() == 3U);
+    REQUIRE(logger.at("noop/0.25").target_rate() == Catch::Approx(0.25));
+    REQUIRE(logger.at("noop/0.4").target_rate() == Catch::Approx(0.4));
+    REQUIRE(logger.at("noop/2.5").target_rate() == Catch::Approx(2.5));
+}
+
+TEST_CASE("load-generator-coordinated-omission", "[benchmark-load]") {
+    auto logger = load_logger<std::chrono::microseconds>{};
+    // Each call takes about 2ms, scheduled every 1ms: calls queue up behind each other
+    auto generator = load_generator<std::chrono::microseconds>{logger, load_options{.rates = {1000.0}, .duration = 20ms}};
+    auto const records = generator.run("slow", [] { std::this_thread::sleep_for(2ms); });
+    REQUIRE(records.size() == 1U);
+    auto const &record = records.front();
+    REQUIRE(record.latency().count() == 20U);
+    REQUIRE(record.service_time().min() >= 2ms);
+    // The last call was scheduled at 19ms and completed after at least 40ms
+    REQUIRE(record.latency().max() >= 20ms);
+    REQUIRE(record.latency().max() > record.service_time().median() * 5);
+    REQUIRE(record.achieved_rate() < 600.0);
+}
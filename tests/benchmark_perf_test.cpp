@@ -0,0 +1,104 @@
+#include "cpputils/misc/benchmark_perf.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+static_assert(time_counter<perf_counter<>>);
+static_assert(time_record<perf_record<>>);
+
+TEST_CASE("perf-counter-measurement", "[benchmark-perf]") {
+    perf_counter<> counter{};
+    counter.start();
+    std::vector<std::uint64_t> v(10'000U);
+    std::iota(v.begin(), v.end(), std::uint64_t{0});
+    counter.stop();
+    auto const measurement = counter.measurement();
+    REQUIRE(measurement.elapsed == counter.delta());
+    REQUIRE(measurement.available == perf_counter<>::available_events());
+    if (measurement.available.test(static_cast<std::size_t>(perf_event::instructions))) {
+        REQUIRE(measurement[perf_event::instructions] > 0U);
+    }
+}
+
+TEST_CASE("perf-counter-kernel-events", "[benchmark-perf]") {
+    perf_counter<> counter{};
+    counter.start();
+    // Fresh pages fault on their first write
+    std::vector<std::uint64_t> v(1U << 22U);
+    std::iota(v.begin(), v.end(), std::uint64_t{0});
+    counter.stop();
+    auto const measurement = counter.measurement();
+    if (measurement.available.test(static_cast<std::size_t>(perf_event::page_faults))) {
+        REQUIRE(measurement[perf_event::page_faults] > 0U);
+    }
+}
+
+TEST_CASE("perf-counter-multiplexed-scaling", "[benchmark-perf]") {
+    using reading = cpputils::benchmark::detail::perf_group::reading;
+    auto const cycles = static_cast<std::size_t>(perf_event::cycles);
+    reading start{.time_enabled = 100U, .time_running = 50U};
+    start.values[cycles] = 1'000U;
+    reading stop{.time_enabled = 300U, .time_running = 150U};
+    stop.values[cycles] = 2'000U;
+    // Counting half of the time enabled
+    REQUIRE(cpputils::benchmark::detail::scaled_delta(start, stop)[cycles] == 2'000U);
+    stop.time_running = 250U;
+    // Counting the whole time
+    REQUIRE(cpputils::benchmark::detail::scaled_delta(start, stop)[cycles] == 1'000U);
+}
+
+TEST_CASE("perf-record-with-timer", "[benchmark-perf]") {
+    auto logger = perf_logger<>{};
+    for (int i = 0; i < 4; ++i) {
+        timer<perf_logger<>, perf_counter<>>::scoped const t{logger, "section"};
+    }
+    auto const &record = logger.at("section");
+    REQUIRE(record.count() == 4U);
+    auto const available = perf_counter<>::available_events();
+    for (std::size_t i = 0; i < perf_event_count; ++i) {
+        REQUIRE(std::isnan(record.mean(static_cast<perf_event>(i))) == !available.test(i));
+    }
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,samples,elapsed,cycles,instructions,branch_misses,cache_misses,task_clock,page_faults,context_switches,ipc,unit_of_measure\n"));
+}
+
+TEST_CASE("perf-record-elapsed-only", "[benchmark-perf]") {
+    auto logger = perf_logger<>{};
+    {
+        timer<perf_logger<>>::scoped const t{logger, "section"};
+    }
+    auto const &record = logger.at("section");
+    REQUIRE(record.count() == 1U);
+    REQUIRE(std::isnan(record.mean(perf_event::cycles)));
+    REQUIRE(std::isnan(record.instructions_per_cycle()));
+}
+
+TEST_CASE("perf-record-derived-metrics", "[benchmark-perf]") {
+    perf_measurement<std::chrono::nanoseconds> measurement{.elapsed = 10ns};
+    measurement.values[static_cast<std::size_t>(perf_event::cycles)] = 100U;
+    measurement.values[static_cast<std::size_t>(perf_event::instructions)] = 250U;
+    measurement.available.set(static_cast<std::size_t>(perf_event::cycles));
+    measurement.available.set(static_cast<std::size_t>(perf_event::instructions));
+
+    perf_record<std::chrono::nanoseconds> record{};
+    record.record(measurement);
+    record.record(measurement);
+    REQUIRE(record.elapsed() == 10ns);
+    REQUIRE(record.mean(perf_event::cycles) == Catch::Approx(100.0));
+    REQUIRE(record.instructions_per_cycle() == Catch::Approx(2.5));
+
+    auto merged = record;
+    merged.merge(record);
+    REQUIRE(merged.count() == 4U);
+    REQUIRE(merged.mean(perf_event::instructions) == Catch::Approx(250.0));
+}
@@ -0,0 +1,33 @@
+// CPPUTILS_ENABLE_PROFILING is not defined: the macros compile to nothing
+#include "cpputils/misc/benchmark_profile.hpp"
+#include "cpputils/misc/benchmark_concurrent.hpp"
+#include <catch2/catch_all.hpp>
+#include <string_view>
+#include <type_traits>
+
+
+using namespace cpputils::benchmark;
+
+namespace {
+int unprofiled_function(int value) {
+    CPPUTILS_PROFILE_FUNCTION();
+    CPPUTILS_PROFILE_SCOPE("unprofiled_scope");
+    return value * 2;
+}
+}  // namespace
+
+static_assert(std::is_void_v<decltype(CPPUTILS_PROFILE_SCOPE("unprofiled_scope"))>);
+static_assert(std::is_void_v<decltype(CPPUTILS_PROFILE_FUNCTION())>);
+
+TEST_CASE("profile-macros-disabled", "[benchmark-profile]") {
+    REQUIRE(unprofiled_function(2) == 4);
+    {
+        CPPUTILS_PROFILE_SCOPE("unprofiled_scope");
+    }
+    // The enabled test registers its own sections in the same logger
+    auto const logger = get_static_logger<concurrent_logger<>>().snapshot();
+    REQUIRE_FALSE(logger.contains("unprofiled_scope"));
+    for (auto const &entry : logger) {
+        REQUIRE(std::string_view{entry.first}.find("unprofiled_function") == std::string_view::npos);
+    }
+}
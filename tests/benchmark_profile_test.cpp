@@ -0,0 +1,51 @@
+#define CPPUTILS_ENABLE_PROFILING
+#include "cpputils/misc/benchmark_profile.hpp"
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+namespace {
+int profiled_function(int value) {
+    CPPUTILS_PROFILE_FUNCTION();
+    CPPUTILS_PROFILE_SCOPE("profiled_scope");
+    return value * 2;
+}
+}  // namespace
+
+static_assert(std::is_same_v<profile_logger_t, concurrent_logger<>>);
+
+TEST_CASE("profile-macros", "[benchmark-profile]") {
+    REQUIRE(profiled_function(2) == 4);
+    REQUIRE(profiled_function(3) == 6);
+    {
+        CPPUTILS_PROFILE_SCOPE("profiled_scope");
+        CPPUTILS_PROFILE_SCOPE("nested_scope");
+    }
+    REQUIRE(&profile_logger() == &get_static_logger<concurrent_logger<>>());
+    auto const logger = profile_logger().snapshot();
+    REQUIRE(logger.contains("profiled_scope"));
+    REQUIRE(logger.contains("nested_scope"));
+    REQUIRE(std::ranges::any_of(logger, [](auto const &entry) {
+        return std::string_view{entry.first}.find("profiled_function") != std::string_view::npos;
+    }));
+}
+
+TEST_CASE("profile-macros-from-threads", "[benchmark-profile]") {
+    std::vector<std::thread> threads{};
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([] {
+            for (int j = 0; j < 100; ++j) {
+                CPPUTILS_PROFILE_SCOPE("threaded_scope");
+            }
+        });
+    }
+    for (auto &t : threads) { t.join(); }
+    REQUIRE(profile_logger().snapshot().contains("threaded_scope"));
+}
@@ -0,0 +1,79 @@
+#include "cpputils/misc/benchmark_registry.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+namespace {
+std::vector<complexity_point> points_of(auto f) {
+    std::vector<complexity_point> points{};
+    for (auto const n : size_range(8U, 8'192U)) {
+        points.emplace_back(n, f(static_cast<double>(n)));
+    }
+    return points;
+}
+}  // namespace
+
+TEST_CASE("size-range", "[benchmark-registry]") {
+    REQUIRE(size_range(8U, 64U) == std::vector<std::size_t>{8U, 16U, 32U, 64U});
+    REQUIRE(size_range(1U, 1'000U, 10U) == std::vector<std::size_t>{1U, 10U, 100U, 1'000U});
+    REQUIRE(size_range(10U, 5U).empty());
+    auto constexpr max = std::numeric_limits<std::size_t>::max();
+    auto const sizes = size_range(1U, max);
+    REQUIRE(sizes.size() == std::numeric_limits<std::size_t>::digits);
+    REQUIRE(sizes.back() == max / 2U + 1U);
+    REQUIRE(size_range(max, max) == std::vector<std::size_t>{max});
+}
+
+TEST_CASE("fit-complexity", "[benchmark-registry]") {
+    auto const check = [](auto f, complexity expected, double coefficient) {
+        auto const fit = fit_complexity(points_of(f));
+        REQUIRE(fit.has_value());
+        REQUIRE(fit->best == expected);
+        REQUIRE(fit->coefficient == Catch::Approx(coefficient).epsilon(0.05));
+    };
+    check([](double) { return 40.0; }, complexity::constant, 40.0);
+    check([](double n) { return 3.0 * std::log2(n); }, complexity::logarithmic, 3.0);
+    check([](double n) { return 2.0 * n + 5.0; }, complexity::linear, 2.0);
+    check([](double n) { return 0.5 * n * std::log2(n); }, complexity::linearithmic, 0.5);
+    check([](double n) { return 0.1 * n * n + n; }, complexity::quadratic, 0.1);
+
+    REQUIRE_FALSE(fit_complexity(std::vector<complexity_point>{{4U, 1.0}, {4U, 2.0}}).has_value());
+}
+
+TEST_CASE("registry-runs-parameter-space", "[benchmark-registry]") {
+    auto logger = statistics_logger<std::chrono::duration<double, std::nano>>{};
+    registry<decltype(logger)> benchmarks{};
+    benchmarks
+        .add("accumulate", size_range(16U, 1'024U, 4U),
+             [](std::size_t n) { return std::vector<int>(n, 1); },
+             [](std::vector<int> const &v) { return std::accumulate(v.cbegin(), v.cend(), 0); })
+        .add("noop", {1U, 1'000U}, [](std::size_t n) { return n; });
+    REQUIRE(benchmarks.size() == 2U);
+
+    auto const results = benchmarks.run(logger, {.warmup_rounds = 1, .samples = 5, .target_time = 1ms});
+    REQUIRE(results.size() == 2U);
+    REQUIRE(results[0].name == "accumulate");
+    REQUIRE(results[0].time_unit == "nanoseconds");
+    REQUIRE(results[0].points.size() == 4U);
+    REQUIRE(results[0].fit.has_value());
+    REQUIRE(logger.contains("accumulate/16"));
+    REQUIRE(logger.contains("accumulate/1024"));
+    REQUIRE(logger.contains("noop/1000"));
+    REQUIRE(results[0].points.back().second == Catch::Approx(logger.at("accumulate/1024").elapsed().count()));
+
+    std::string csv{};
+    string_sink sink{csv};
+    write_complexity(results, sink);
+    REQUIRE(csv.starts_with("benchmark,complexity,coefficient,rms,unit_of_measure\naccumulate,O("));
+    REQUIRE(csv.ends_with(",nanoseconds\n"));
+}
@@ -0,0 +1,109 @@
+#include "cpputils/misc/benchmark_runner.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+TEST_CASE("sample-set-statistics", "[benchmark-runner]") {
+    sample_set<std::chrono::nanoseconds> set{};
+    for (auto i = 100; i > 0; --i) {
+        set.record(std::chrono::nanoseconds{i});
+    }
+    REQUIRE(set.count() == 100U);
+    REQUIRE(set.min() == 1ns);
+    REQUIRE(set.max() == 100ns);
+    REQUIRE(set.median() == 51ns);
+    REQUIRE(set.mean() == 51ns);
+    REQUIRE(set.percentile(0.9) == 91ns);
+    REQUIRE(set.percentile(0.99) == 100ns);
+    REQUIRE(set.stddev() == 29ns);
+    REQUIRE(set.elapsed() == set.median());
+}
+
+TEST_CASE("sample-set-empty", "[benchmark-runner]") {
+    sample_set<> const set{};
+    REQUIRE(set.count() == 0U);
+    REQUIRE(set.median() == default_duration{});
+    REQUIRE(set.stddev() == default_duration{});
+}
+
+TEST_CASE("timer-accumulates-samples", "[benchmark-runner]") {
+    auto logger = statistics_logger<>{};
+    for (int i = 0; i < 3; ++i) {
+        timer<statistics_logger<>>::scoped const t{logger, "section"};
+    }
+    REQUIRE(logger.at("section").count() == 3U);
+}
+
+TEST_CASE("runner-records-samples", "[benchmark-runner]") {
+    auto logger = statistics_logger<>{};
+    auto r = runner<>{logger, run_options{.warmup_rounds = 2, .samples = 20, .target_time = 2ms}};
+    std::vector<int> const v(64, 1);
+    auto const record = r.run("accumulate", [](auto const &values) { return std::accumulate(values.cbegin(), values.cend(), 0); }, v);
+    REQUIRE(record.count() == 20U);
+    REQUIRE(record.min() <= record.median());
+    REQUIRE(record.median() <= record.percentile(0.9));
+    REQUIRE(record.percentile(0.9) <= record.max());
+
+    r.run("accumulate", [] {});
+    REQUIRE(logger.at("accumulate").count() == 20U);
+}
+
+TEST_CASE("runner-report", "[benchmark-runner]") {
+    auto logger = statistics_logger<>{};
+    auto r = runner<>{logger, run_options{.warmup_rounds = 0, .samples = 5, .target_time = 1ms}};
+    r.run("noop", [] {});
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,samples,min,median,mean,p90,p99,max,stddev,unit_of_measure\n"));
+    REQUIRE(csv.find("noop,5,") != std::string::npos);
+
+    auto const yaml = reporter<>::report<formatters::yaml>(logger);
+    REQUIRE(yaml.find("noop: {samples: 5, min: ") != std::string::npos);
+}
+
+TEST_CASE("runner-throughput", "[benchmark-runner]") {
+    using logger_t = throughput_logger<sample_set<>>;
+    auto logger = logger_t{};
+    auto r = runner<logger_t>{logger, run_options{.warmup_rounds = 1, .samples = 5, .target_time = 1ms}};
+    std::vector<int> const v(256, 1);
+    auto const record = r.run("accumulate", processed{.items = v.size(), .bytes = v.size() * sizeof(int)}, [](auto const &values) { return std::accumulate(values.cbegin(), values.cend(), 0); }, v);
+    REQUIRE(record.base().count() == 5U);
+    REQUIRE(record.items() == Catch::Approx(256.0));
+    REQUIRE(record.bytes() == Catch::Approx(256.0 * sizeof(int)));
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,samples,min,median,mean,p90,p99,max,stddev,items,bytes,items_per_second,bytes_per_second,unit_of_measure\n"));
+}
+
+TEST_CASE("runner-cache-modes", "[benchmark-runner]") {
+    auto logger = statistics_logger<>{};
+    std::vector<int> const v(4096, 1);
+    auto const sum = [](auto const &values) { return std::accumulate(values.cbegin(), values.cend(), 0); };
+
+    auto cold = runner<>{logger, run_options{.warmup_rounds = 1, .samples = 5, .target_time = 1ms, .cache = cache_mode::cold, .eviction_bytes = std::size_t{1} << 20U}};
+    auto warm = runner<>{logger, run_options{.warmup_rounds = 1, .samples = 5, .target_time = 1ms, .cache = cache_mode::warm}};
+    REQUIRE(cold.run("sum", sum, v).count() == 5U);
+    REQUIRE(warm.run("sum", sum, v).count() == 5U);
+    REQUIRE(logger.size() == 2U);
+    REQUIRE(logger.contains("sum/cold"));
+    REQUIRE(logger.contains("sum/warm"));
+}
+
+TEST_CASE("cache-helpers", "[benchmark-runner]") {
+    REQUIRE(last_level_cache_size() > 0U);
+    cache_evictor evictor{4096U};
+    REQUIRE(evictor.size() == 4096U);
+    evictor.evict();
+    std::vector<std::byte> const bytes(100U);
+    touch(bytes);
+    touch({});
+    REQUIRE(to_string(cache_mode::cold) == "cold");
+    REQUIRE(to_string(cache_mode::unlabelled).empty());
+}
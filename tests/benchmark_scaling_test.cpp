@@ -0,0 +1,62 @@
+#include "cpputils/misc/benchmark_scaling.hpp"
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+TEST_CASE("scaling-thread-counts", "[benchmark-scaling]") {
+    REQUIRE(thread_counts(0U) == std::vector<std::size_t>{1U});
+    REQUIRE(thread_counts(1U) == std::vector<std::size_t>{1U});
+    REQUIRE(thread_counts(8U) == std::vector<std::size_t>{1U, 2U, 4U, 8U});
+    REQUIRE(thread_counts(6U) == std::vector<std::size_t>{1U, 2U, 4U, 6U});
+}
+
+TEST_CASE("scaling-runner", "[benchmark-scaling]") {
+    auto logger = histogram_logger<>{};
+    auto r = scaling_runner<>{logger, scaling_options{.max_threads = 3U, .duration = 20ms}};
+    std::vector<std::atomic<std::uint64_t>> calls_by_thread(3U);
+    auto const points = r.run("work", [&calls_by_thread](std::size_t thread) {
+        calls_by_thread[thread].fetch_add(1U, std::memory_order_relaxed);
+    });
+
+    REQUIRE(points.size() == 3U);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        REQUIRE(points[i].threads == i + 1U);
+        REQUIRE(points[i].calls > 0U);
+        REQUIRE(points[i].wall_time >= 20ms);
+        REQUIRE(points[i].throughput > 0.0);
+        REQUIRE(points[i].efficiency > 0.0);
+        for (std::size_t thread = 0; thread <= i; ++thread) {
+            auto const key = "work/" + std::to_string(i + 1U) + "/" + std::to_string(thread);
+            REQUIRE(logger.contains(key));
+            REQUIRE(logger.at(key).count() > 0U);
+        }
+    }
+    REQUIRE(points.front().efficiency == Catch::Approx(1.0));
+    std::uint64_t total{};
+    for (auto const &calls : calls_by_thread) { total += calls.load(); }
+    REQUIRE(total == points[0].calls + points[1].calls + points[2].calls);
+
+    std::string csv{};
+    string_sink sink{csv};
+    write_scaling(points, sink);
+    REQUIRE(csv.starts_with("threads,pinned,calls,wall_time,throughput,efficiency\n1,"));
+}
+
+TEST_CASE("scaling-runner-without-index", "[benchmark-scaling]") {
+    auto logger = histogram_logger<>{};
+    auto r = scaling_runner<>{logger, scaling_options{.max_threads = 1U, .duration = 5ms, .pin_threads = false}};
+    std::atomic<std::uint64_t> calls{};
+    auto const points = r.run("work", [&calls] { calls.fetch_add(1U); });
+    REQUIRE(points.size() == 1U);
+    REQUIRE_FALSE(points.front().pinned);
+    REQUIRE(points.front().calls == calls.load());
+}
@@ -1,8 +1,17 @@
 #include "cpputils/misc/benchmark.hpp"
 #include <catch2/catch_all.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <ratio>
+#include <sstream>
+#include <string>
+#include <unordered_map>
 #include <thread>
+#include <vector>
 
 
 using namespace cpputils::benchmark;
@@ -32,4 +41,258 @@ TEST_CASE("benchmark-should-compile", "[check-compilation]") {
     auto const time_report = reporter<>::report<formatters::csv>(logger);
 
     std::cout << time_report;
-}
\ No newline at end of file
+}
+
+TEST_CASE("timer-section", "[benchmark-section]") {
+    auto logger = timer<>::logger_t{};
+    auto section = timer<>::section{logger, "section"};
+    {
+        timer<>::scoped const t{section};
+    }
+    REQUIRE(logger.size() == 1U);
+    REQUIRE(logger.contains("section"));
+
+    timer<> manual{logger};
+    manual.start(section);
+    manual.stop();
+    manual.start("other");
+    manual.stop();
+    REQUIRE(logger.size() == 2U);
+}
+
+TEST_CASE("timer-static-section", "[benchmark-section]") {
+    using logger_t = std::unordered_map<std::string, std::chrono::duration<double, std::nano>>;
+    auto &section = timer<logger_t>::static_section<"static_section">();
+    REQUIRE(&section == &timer<logger_t>::static_section<"static_section">());
+    {
+        timer<logger_t>::scoped const t{section};
+    }
+    REQUIRE(get_static_logger<logger_t>().contains("static_section"));
+}
+
+TEST_CASE("report-streamed-to-ostream", "[benchmark-stream]") {
+    auto logger = std::unordered_map<std::string, std::chrono::nanoseconds>{{"fast", 10ns}, {"slow", 30ns}, {"medium", 20ns}};
+
+    std::ostringstream sorted{};
+    reporter<>::write<formatters::csv>(logger, sorted, report_order::by_elapsed);
+    REQUIRE(sorted.str() == reporter<>::report<formatters::csv>(logger));
+    REQUIRE(sorted.str() == "description,elapsed_time,unit_of_measure\nslow,30,nanoseconds\nmedium,20,nanoseconds\nfast,10,nanoseconds\n");
+
+    std::ostringstream as_logged{};
+    reporter<>::write<formatters::yaml>(logger, as_logged);
+    for (auto const &[key, value] : logger) {
+        REQUIRE(as_logged.str().find(key + ": " + std::to_string(value.count()) + "\n") != std::string::npos);
+    }
+}
+
+TEST_CASE("report-streamed-in-chunks", "[benchmark-stream]") {
+    struct counting_sink {
+        std::string content{};
+        std::size_t chunks{};
+        void write(std::string_view chunk) {
+            REQUIRE(chunk.size() <= report_writer<counting_sink>::buffer_size);
+            content += chunk;
+            ++chunks;
+        }
+    };
+
+    auto logger = std::map<std::string, std::chrono::duration<double, std::micro>>{};
+    for (int i = 0; i < 1'000; ++i) {
+        logger["section_" + std::to_string(i)] = std::chrono::duration<double, std::micro>{i / 4.0};
+    }
+    counting_sink sink{};
+    reporter<>::write<formatters::json>(logger, sink);
+    REQUIRE(sink.chunks > 1U);
+    REQUIRE(sink.content.find("        \"section_3\": 0.75,\n") != std::string::npos);
+    REQUIRE(sink.content.ends_with("        \"section_999\": 249.75\n    }\n}\n"));
+}
+
+#ifdef CPPUTILS_POSIX_PLATFORM
+TEST_CASE("report-streamed-to-file-descriptor", "[benchmark-stream]") {
+    auto logger = std::unordered_map<std::string, std::chrono::milliseconds>{{"section", 5ms}};
+    auto *const file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    fd_sink sink{fileno(file)};
+    reporter<>::write<formatters::csv>(logger, sink);
+    REQUIRE_FALSE(sink.failed());
+
+    std::rewind(file);
+    std::string content(128U, '\0');
+    content.resize(std::fread(content.data(), 1U, content.size(), file));
+    std::fclose(file);
+    REQUIRE(content == "description,elapsed_time,unit_of_measure\nsection,5,milliseconds\n");
+}
+#endif
+
+namespace {
+struct copy_counter {
+    inline static int copies{};
+    std::vector<int> data = std::vector<int>(1'000, 1);
+
+    copy_counter() = default;
+    copy_counter(copy_counter const &other)
+        : data{other.data} {
+        ++copies;
+    }
+    copy_counter(copy_counter &&) = delete;
+    copy_counter &operator=(copy_counter const &) = delete;
+    copy_counter &operator=(copy_counter &&) = delete;
+    ~copy_counter() = default;
+};
+}  // namespace
+
+TEST_CASE("benchmark-this-does-not-copy-results", "[benchmark-optimize]") {
+    auto logger = timer<>::logger_t{};
+    timer<> t{logger};
+    copy_counter const kept{};
+    copy_counter::copies = 0;
+    t.benchmark_this("by_reference", [&kept]() -> copy_counter const & { return kept; });
+    t.benchmark_this("by_value", [] { return copy_counter{}; });
+    REQUIRE(copy_counter::copies == 0);
+
+    std::mutex m{};
+    t.benchmark_this("non_copyable", [&m]() -> std::mutex & { return m; });
+    int side_effect{};
+    t.benchmark_this("void", [&side_effect] { ++side_effect; });
+    REQUIRE(side_effect == 1);
+    REQUIRE(logger.size() == 4U);
+}
+
+TEST_CASE("do-not-optimize-in-manual-loops", "[benchmark-optimize]") {
+    auto logger = timer<>::logger_t{};
+    timer<> t{logger};
+    std::vector<int> v(100U, 0);
+    t.start("loop");
+    for (auto &x : v) {
+        x += 1;
+        do_not_optimize(x);
+    }
+    clobber_memory();
+    t.stop();
+    do_not_optimize(copy_counter{});
+    REQUIRE(std::ranges::all_of(v, [](int x) { return x == 1; }));
+    REQUIRE(logger.contains("loop"));
+}
+
+TEST_CASE("sampled-timer-one-in-n", "[benchmark-sampling]") {
+    using logger_t = sampled_logger<std::chrono::nanoseconds>;
+    auto logger = logger_t{};
+    sampler s{4U};
+    for (int i = 0; i < 10; ++i) {
+        timer<logger_t>::sampled const t{logger, "hot", s};
+    }
+    auto const &record = logger.at("hot");
+    REQUIRE(record.samples() == 2U);
+    REQUIRE(record.calls() == 8U);
+    REQUIRE(record.elapsed() <= record.total());
+
+    auto section = timer<logger_t>::section{logger, "section"};
+    sampler every_call{1U};
+    for (int i = 0; i < 3; ++i) {
+        timer<logger_t>::sampled const t{section, every_call};
+    }
+    REQUIRE(logger.at("section").samples() == 3U);
+    REQUIRE(logger.at("section").calls() == 3U);
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,samples,calls,total,mean,unit_of_measure\n"));
+}
+
+TEST_CASE("sampled-timer-plain-logger", "[benchmark-sampling]") {
+    auto logger = timer<>::logger_t{};
+    sampler s{3U};
+    for (int i = 0; i < 2; ++i) {
+        timer<>::sampled const t{logger, "hot", s};
+    }
+    REQUIRE(logger.empty());
+    {
+        timer<>::sampled const t{logger, "hot", s};
+    }
+    REQUIRE(logger.contains("hot"));
+}
+
+TEST_CASE("sampler-time-based", "[benchmark-sampling]") {
+    sampler s{1s};
+    REQUIRE(s.sample());
+    REQUIRE(s.weight() == 1U);
+    // Calls much more frequent than one per second: the period grows
+    for (int i = 0; i < 8; ++i) {
+        while (!s.sample()) {}
+    }
+    auto const fast_weight = s.weight();
+    REQUIRE(fast_weight > 1U);
+
+    sampler slow{1ms};
+    for (int i = 0; i < 4; ++i) {
+        while (!slow.sample()) {}
+    }
+    auto const before_sleep = slow.weight();
+    std::this_thread::sleep_for(20ms);
+    while (!slow.sample()) {}
+    // Calls rarer than one per millisecond: the period shrinks
+    while (!slow.sample()) {}
+    REQUIRE(slow.weight() < std::max(before_sleep, std::uint64_t{2}));
+
+    sampled_record<std::chrono::nanoseconds> record{};
+    record.record(weighted_sample<std::chrono::nanoseconds>{.elapsed = 10ns, .weight = 10U});
+    record.record(weighted_sample<std::chrono::nanoseconds>{.elapsed = 40ns, .weight = 5U});
+    REQUIRE(record.samples() == 2U);
+    REQUIRE(record.calls() == 15U);
+    REQUIRE(record.total() == 300ns);
+    REQUIRE(record.elapsed() == 20ns);
+}
+
+TEST_CASE("timer-with-processed-work", "[benchmark-throughput]") {
+    using logger_t = throughput_logger<sampled_record<std::chrono::nanoseconds>>;
+    auto logger = logger_t{};
+    for (int i = 0; i < 2; ++i) {
+        timer<logger_t>::scoped const t{logger, "copy", processed{.items = 10U, .bytes = 80U}};
+        std::this_thread::sleep_for(1ms);
+    }
+    timer<logger_t> manual{logger};
+    auto const elapsed = manual.benchmark_this("sum", processed{.items = 4U}, [](int a, int b) { return a + b; }, 1, 2);
+    REQUIRE(elapsed >= 0ns);
+    {
+        timer<logger_t>::scoped const t{logger, "unknown"};
+    }
+
+    auto const &copy = logger.at("copy");
+    REQUIRE(copy.base().samples() == 2U);
+    REQUIRE(copy.items() == Catch::Approx(10.0));
+    REQUIRE(copy.bytes() == Catch::Approx(80.0));
+    REQUIRE(logger.at("sum").items() == Catch::Approx(4.0));
+    REQUIRE(logger.at("sum").bytes() == Catch::Approx(0.0));
+    REQUIRE(logger.at("unknown").items() == Catch::Approx(0.0));
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,samples,calls,total,mean,items,bytes,items_per_second,bytes_per_second,unit_of_measure\n"));
+    auto const json = reporter<>::report<formatters::json>(logger);
+    REQUIRE(json.find("\"items_per_second\": ") != std::string::npos);
+    REQUIRE(json.find("\"bytes_per_second\": ") != std::string::npos);
+    for (auto const &report : {reporter<>::report<formatters::yaml>(logger), reporter<>::report<formatters::markdown>(logger), reporter<>::report<formatters::html>(logger)}) {
+        REQUIRE(report.find("items_per_second: ") != std::string::npos);
+        REQUIRE(report.find("bytes_per_second: ") != std::string::npos);
+    }
+
+    // At most 10 items in 1ms
+    std::istringstream lines{csv};
+    std::string line{};
+    while (std::getline(lines, line)) {
+        if (!line.starts_with("copy,")) { continue; }
+        std::istringstream cells{line};
+        std::vector<std::string> values{};
+        for (std::string cell{}; std::getline(cells, cell, ',');) { values.push_back(cell); }
+        REQUIRE(std::stod(values[7]) <= 10.0 / 1e-3);
+        REQUIRE(std::stod(values[8]) == Catch::Approx(std::stod(values[7]) * 8.0));
+    }
+}
+
+TEST_CASE("processed-work-without-throughput-record", "[benchmark-throughput]") {
+    auto logger = timer<>::logger_t{};
+    {
+        timer<>::scoped const t{logger, "section", processed{.items = 1U, .bytes = 1U}};
+    }
+    REQUIRE(logger.contains("section"));
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,elapsed_time,unit_of_measure\n"));
+}
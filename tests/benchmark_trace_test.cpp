@@ -0,0 +1,102 @@
+#include "cpputils/misc/benchmark_trace.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+static_assert(time_logger<trace_logger>);
+static_assert(time_record<trace_record>);
+
+namespace {
+using trace_timer = timer<trace_logger>;
+}
+
+TEST_CASE("trace-logger-nesting", "[benchmark-trace]") {
+    auto logger = trace_logger{};
+    {
+        trace_timer::scoped const outer{logger, "outer"};
+        for (int i = 0; i < 2; ++i) {
+            trace_timer::scoped const inner{logger, "inner"};
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+    {
+        trace_timer::scoped const other{logger, "other"};
+    }
+
+    auto const events = logger.events();
+    REQUIRE(events.size() == 4U);
+    REQUIRE(events[0].path == "outer");
+    REQUIRE(events[0].depth == 0U);
+    REQUIRE(events[1].path == "outer;inner");
+    REQUIRE(events[1].name() == "inner");
+    REQUIRE(events[1].depth == 1U);
+    REQUIRE(events[2].path == "outer;inner");
+    REQUIRE(events[3].path == "other");
+    REQUIRE(events[1].begin >= events[0].begin);
+    REQUIRE(events[0].self == events[0].duration - events[1].duration - events[2].duration);
+
+    auto const records = logger.snapshot();
+    REQUIRE(records.size() == 3U);
+    REQUIRE(records.at("outer;inner").calls() == 2U);
+    REQUIRE(records.at("outer;inner").total() >= 2ms);
+    REQUIRE(records.at("outer").total() >= records.at("outer;inner").total());
+    REQUIRE(records.at("outer").self() < records.at("outer").total());
+}
+
+TEST_CASE("trace-logger-threads", "[benchmark-trace]") {
+    auto logger = trace_logger{};
+    auto work = [&logger] {
+        trace_timer::scoped const outer{logger, "work"};
+        trace_timer::scoped const inner{logger, "step"};
+    };
+    std::thread first{work};
+    first.join();
+    std::thread second{work};
+    second.join();
+
+    auto const events = logger.events();
+    REQUIRE(events.size() == 4U);
+    REQUIRE(events[0].thread != events[2].thread);
+    REQUIRE(logger.snapshot().at("work;step").calls() == 2U);
+
+    auto const copy = logger;
+    REQUIRE(copy.events().size() == 4U);
+    REQUIRE(copy.snapshot().at("work").calls() == 2U);
+}
+
+TEST_CASE("trace-logger-unmatched-stop", "[benchmark-trace]") {
+    auto logger = trace_logger{};
+    logger.record("orphan", 5ns);
+    auto const events = logger.events();
+    REQUIRE(events.size() == 1U);
+    REQUIRE(events[0].path == "orphan");
+    REQUIRE(events[0].self == 5ns);
+}
+
+TEST_CASE("trace-formatters", "[benchmark-trace]") {
+    auto logger = trace_logger{};
+    {
+        trace_timer::scoped const outer{logger, "outer"};
+        trace_timer::scoped const inner{logger, "in\"ner"};
+    }
+
+    using trace_reporter = reporter<formatters::chrome_trace, formatters::collapsed_stacks>;
+    auto const chrome = trace_reporter::report<formatters::chrome_trace>(logger);
+    auto const collapsed = trace_reporter::report<formatters::collapsed_stacks>(logger);
+    REQUIRE(chrome.starts_with("{\"traceEvents\": [\n"));
+    REQUIRE(chrome.find("\"name\": \"outer\", \"cat\": \"cpputils\", \"ph\": \"X\"") != std::string::npos);
+    REQUIRE(chrome.find("\"path\": \"outer;in\\\"ner\"") != std::string::npos);
+    REQUIRE(chrome.ends_with("], \"displayTimeUnit\": \"ns\"}\n"));
+
+    REQUIRE(collapsed.starts_with("outer "));
+    REQUIRE(collapsed.find("\nouter;in\"ner ") != std::string::npos);
+
+    auto const csv = reporter<>::report<formatters::csv>(logger);
+    REQUIRE(csv.starts_with("description,calls,total,self,unit_of_measure\n"));
+}
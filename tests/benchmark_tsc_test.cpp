@@ -0,0 +1,36 @@
+#include "cpputils/misc/benchmark_tsc.hpp"
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <thread>
+
+
+using namespace cpputils::benchmark;
+
+using namespace std::literals;
+
+static_assert(time_counter<tsc_counter<>>);
+
+TEST_CASE("tsc-counter-measures-time", "[benchmark-tsc]") {
+    tsc_counter<>::calibrate();
+    if (tsc_counter<>::uses_tsc()) {
+        REQUIRE(tsc_counter<>::nanoseconds_per_cycle() > 0.0);
+#ifdef CPPUTILS_X86_PLATFORM
+        REQUIRE(cpputils::benchmark::detail::has_rdtscp());
+#endif
+    }
+    tsc_counter<> counter{};
+    counter.start();
+    std::this_thread::sleep_for(5ms);
+    counter.stop();
+    REQUIRE(counter.delta() >= 4ms);
+    REQUIRE(counter.delta() < 5s);
+}
+
+TEST_CASE("tsc-counter-with-timer", "[benchmark-tsc]") {
+    auto logger = default_logger<>{};
+    {
+        timer<default_logger<>, tsc_counter<>>::scoped const t{logger, "section"};
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(logger.at("section") >= 900us);
+}
@@ -0,0 +1,97 @@
+#include "catch2/catch_test_macros.hpp"
+#include "cpputils/functional/chunk.hpp"
+#include "cpputils/functional/zip.hpp"
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+
+using namespace cpputils;
+
+
+TEST_CASE("chunk test", "[dynamic_size]") {
+    std::vector<int> v(10);
+    std::iota(v.begin(), v.end(), 0);
+
+    auto chunks = v | chunk(4);
+    STATIC_REQUIRE(std::ranges::random_access_range<decltype(chunks)>);
+    STATIC_REQUIRE(std::is_same_v<std::ranges::range_value_t<decltype(chunks)>, std::span<int>>);
+    REQUIRE(chunks.size() == 3);
+
+    std::vector<std::size_t> sizes{};
+    int expected{};
+    for (auto const part : chunks) {
+        sizes.push_back(part.size());
+        for (auto const x : part) {
+            REQUIRE(x == expected);
+            ++expected;
+        }
+    }
+    REQUIRE(sizes == std::vector<std::size_t>{4, 4, 2});
+    REQUIRE(chunks[1].front() == 4);
+}
+
+TEST_CASE("chunk test", "[static_size]") {
+    std::vector<int> v(10);
+    std::iota(v.begin(), v.end(), 0);
+
+    auto chunks = v | chunk(chunk_size<4>);
+    STATIC_REQUIRE(std::is_same_v<std::ranges::range_value_t<decltype(chunks)>, std::span<int, 4>>);
+    REQUIRE(chunks.size() == 2);
+
+    int sum{};
+    for (auto const part : chunks) {
+        for (std::size_t i = 0; i < part.size(); ++i) {
+            sum += part[i];
+        }
+    }
+    REQUIRE(sum == 0 + 1 + 2 + 3 + 4 + 5 + 6 + 7);
+
+    auto const rest = chunks.remainder();
+    REQUIRE(rest.size() == 2);
+    REQUIRE(rest[0] == 8);
+    REQUIRE(rest[1] == 9);
+
+    auto exact = std::array{1, 2, 3, 4} | chunk(chunk_size<2>);
+    REQUIRE(exact.size() == 2);
+    REQUIRE(exact.remainder().empty());
+}
+
+TEST_CASE("chunk test", "[mutate]") {
+    std::vector<int> v{1, 2, 3, 4, 5};
+    for (auto const part : v | chunk(2)) {
+        for (auto &x : part) {
+            x *= 10;
+        }
+    }
+    REQUIRE(v == std::vector{10, 20, 30, 40, 50});
+}
+
+TEST_CASE("chunk test", "[zip]") {
+    std::vector<float> a{1.0F, 2.0F, 3.0F, 4.0F, 5.0F};
+    std::vector<float> const b{10.0F, 20.0F, 30.0F, 40.0F, 50.0F, 60.0F};
+
+    auto chunks = zip(a, b) | chunk(chunk_size<2>);
+    STATIC_REQUIRE(std::is_same_v<std::ranges::range_value_t<decltype(chunks)>, std::tuple<std::span<float, 2>, std::span<float const, 2>>>);
+    REQUIRE(chunks.size() == 2);
+
+    for (auto const [lhs, rhs] : chunks) {
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            lhs[i] += rhs[i];
+        }
+    }
+    auto const [lhs_rest, rhs_rest] = chunks.remainder();
+    REQUIRE(lhs_rest.size() == 1);
+    lhs_rest[0] += rhs_rest[0];
+
+    std::vector<float> const expected{11.0F, 22.0F, 33.0F, 44.0F, 55.0F};
+    REQUIRE(a == expected);
+
+    auto dynamic = zip(a, b) | chunk(3);
+    REQUIRE(std::get<0>(dynamic[1]).size() == 2);
+}
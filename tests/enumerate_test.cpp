@@ -2,6 +2,8 @@
 #include "cpputils/functional/enumerate.hpp"
 #include "cpputils/types/number.hpp"
 #include <cstddef>
+#include <forward_list>
+#include <list>
 #include <ranges>
 #include <vector>
 
@@ -89,3 +91,59 @@ TEST_CASE("enumerate test", "[reference_test]") {
         REQUIRE(v[i] == expected[i]);
     }
 }
+
+TEST_CASE("enumerate test", "[category]") {
+    using vector_enum = decltype(std::declval<std::vector<int> &>() | enumerate());
+    STATIC_REQUIRE(std::ranges::random_access_range<vector_enum>);
+    STATIC_REQUIRE(std::ranges::sized_range<vector_enum>);
+    STATIC_REQUIRE(std::ranges::common_range<vector_enum>);
+
+    using list_enum = decltype(std::declval<std::list<int> &>() | enumerate());
+    STATIC_REQUIRE(std::ranges::bidirectional_range<list_enum>);
+    STATIC_REQUIRE(!std::ranges::random_access_range<list_enum>);
+    STATIC_REQUIRE(std::ranges::sized_range<list_enum>);
+
+    using forward_enum = decltype(std::declval<std::forward_list<int> &>() | enumerate());
+    STATIC_REQUIRE(std::ranges::forward_range<forward_enum>);
+    STATIC_REQUIRE(!std::ranges::bidirectional_range<forward_enum>);
+
+    // Custom indices are only incremented and decremented
+    using number_enum = decltype(std::declval<std::vector<int> &>() | enumerate(0_u8));
+    STATIC_REQUIRE(std::ranges::bidirectional_range<number_enum>);
+    STATIC_REQUIRE(!std::ranges::random_access_range<number_enum>);
+    STATIC_REQUIRE(std::ranges::sized_range<number_enum>);
+}
+
+TEST_CASE("enumerate test", "[random_access]") {
+    std::vector const v{10, 20, 30, 40};
+    auto e = v | enumerate(1);  // NOLINT
+
+    REQUIRE(e.size() == 4);
+    REQUIRE(e.end() - e.begin() == 4);
+    REQUIRE(e[2].index == 3);
+    REQUIRE(e[2].value == 30);
+
+    auto it = e.begin() + 3;
+    REQUIRE((*it).index == 4);
+    it -= 2;
+    REQUIRE((*it).value == 20);
+    REQUIRE(it[1].index == 3);
+    REQUIRE(e.begin() < it);
+
+    std::vector<int> indices{};
+    for (auto [index, value] : e | std::views::reverse) {
+        indices.push_back(index);
+    }
+    REQUIRE(indices == std::vector{4, 3, 2, 1});
+}
+
+TEST_CASE("enumerate test", "[forward_list]") {
+    std::forward_list const l{10, 20, 30};
+    std::size_t expected_index{};
+    for (auto [index, value] : l | enumerate()) {
+        REQUIRE(index == expected_index);
+        REQUIRE(value == 10 * static_cast<int>(index + 1));
+        ++expected_index;
+    }
+    REQUIRE(expected_index == 3);
+}
@@ -1,7 +1,14 @@
 #include "catch2/catch_test_macros.hpp"
 #include "cpputils/functional/zip.hpp"
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <forward_list>
+#include <iterator>
+#include <list>
 #include <ranges>
+#include <sstream>
+#include <string>
 #include <vector>
 
 
@@ -62,3 +69,106 @@ TEST_CASE("zip test", "[can_be_piped]") {
         ++i;
     }
 }
+
+
+TEST_CASE("zip test", "[category]") {
+    using vector_zip = decltype(zip(std::declval<std::vector<int> &>(), std::declval<int (&)[3]>()));
+    STATIC_REQUIRE(std::ranges::random_access_range<vector_zip>);
+    STATIC_REQUIRE(std::ranges::sized_range<vector_zip>);
+    STATIC_REQUIRE(std::ranges::common_range<vector_zip>);
+    STATIC_REQUIRE(std::sortable<std::ranges::iterator_t<vector_zip>>);
+
+    using list_zip = decltype(zip(std::declval<std::vector<int> &>(), std::declval<std::list<int> &>()));
+    STATIC_REQUIRE(std::ranges::bidirectional_range<list_zip>);
+    STATIC_REQUIRE(!std::ranges::random_access_range<list_zip>);
+    STATIC_REQUIRE(std::ranges::sized_range<list_zip>);
+
+    using forward_zip = decltype(zip(std::declval<std::vector<int> &>(), std::declval<std::forward_list<int> &>()));
+    STATIC_REQUIRE(std::ranges::forward_range<forward_zip>);
+    STATIC_REQUIRE(!std::ranges::bidirectional_range<forward_zip>);
+    STATIC_REQUIRE(!std::ranges::sized_range<forward_zip>);
+
+    using input_zip = decltype(zip(std::declval<std::vector<int> &>(), std::declval<std::ranges::istream_view<int> &>()));
+    STATIC_REQUIRE(std::ranges::input_range<input_zip>);
+    STATIC_REQUIRE(!std::ranges::forward_range<input_zip>);
+}
+
+TEST_CASE("zip test", "[random_access]") {
+    std::vector v{1, 2, 3, 4};
+    int arr[] = {10, 20, 30};
+
+    auto z = zip(v, arr);
+    REQUIRE(z.size() == 3);
+    REQUIRE(std::ranges::distance(z) == 3);
+    REQUIRE(std::get<1>(z[2]) == 30);
+
+    auto it = z.begin() + 2;
+    REQUIRE(std::get<0>(*it) == 3);
+    REQUIRE(it - z.begin() == 2);
+    REQUIRE(z.end() - it == 1);
+    --it;
+    REQUIRE(std::get<1>(*it) == 20);
+    REQUIRE(it < z.end());
+    REQUIRE(std::get<0>(*std::ranges::prev(z.end())) == 3);
+}
+
+TEST_CASE("zip test", "[sort]") {
+    std::vector keys{3, 1, 2};
+    std::vector<std::string> values{"c", "a", "b"};
+
+    std::ranges::sort(zip(keys, values));
+    REQUIRE(keys == std::vector{1, 2, 3});
+    REQUIRE(values == std::vector<std::string>{"a", "b", "c"});
+
+    std::ranges::sort(zip(keys, values), std::ranges::greater{}, [](auto const &pair) { return std::get<1>(pair); });
+    REQUIRE(keys == std::vector{3, 2, 1});
+    REQUIRE(values == std::vector<std::string>{"c", "b", "a"});
+}
+
+TEST_CASE("zip test", "[forward]") {
+    std::vector v{1, 2, 3};
+    std::forward_list l{10, 20};
+
+    std::size_t i{};
+    for (auto [v_item, l_item] : zip(v, l)) {
+        REQUIRE(v_item == v[i]);
+        REQUIRE(l_item == 10 * v[i]);
+        ++i;
+    }
+    REQUIRE(i == 2);
+}
+
+TEST_CASE("zip test", "[input]") {
+    std::vector v{1, 2, 3};
+    std::istringstream stream{"10 20 30 40"};
+    std::ranges::istream_view<int> numbers{stream};
+
+    std::size_t i{};
+    for (auto [v_item, n_item] : zip(v, numbers)) {
+        REQUIRE(n_item == 10 * v_item);
+        ++i;
+    }
+    REQUIRE(i == 3);
+}
+
+TEST_CASE("zip test", "[contiguous]") {
+    std::vector<float> a{1.0F, 2.0F, 3.0F, 4.0F};
+    std::array<float, 3> const b{10.0F, 20.0F, 30.0F};
+    float c[] = {0.5F, 0.5F, 0.5F, 0.5F, 0.5F};
+
+    auto z = zip(a, b, c);
+    using iterator = std::ranges::iterator_t<decltype(z)>;
+    STATIC_REQUIRE(sizeof(iterator) == 3 * sizeof(float *) + sizeof(std::ptrdiff_t));
+    REQUIRE(z.size() == 3);
+
+    for (auto [x, y, w] : z) {
+        x = x * y + w;
+    }
+    REQUIRE(a == std::vector{10.5F, 40.5F, 90.5F, 4.0F});
+
+    std::vector<float> reversed{};
+    for (auto [x, y, w] : z | std::views::reverse) {
+        reversed.push_back(y);
+    }
+    REQUIRE(reversed == std::vector{30.0F, 20.0F, 10.0F});
+}
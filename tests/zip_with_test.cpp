@@ -1,6 +1,16 @@
-#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_all.hpp"
 #include "cpputils/functional/zip.hpp"
+#include "cpputils/functional/operator_sections.hpp"
+#include "cpputils/functional/tovector.hpp"
 #include "cpputils/functional/zip_with.hpp"
+#include "cpputils/internal/simd.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
 
@@ -45,3 +55,115 @@ TEST_CASE("zip_with test", "[can_be_piped]") {
         ++i;
     }
 }
+
+namespace {
+template <typename T>
+std::vector<T> sequence(std::size_t n, T first, T step) {
+    std::vector<T> v(n);
+    for (auto &x : v) {
+        x = first;
+        first = static_cast<T>(first + step);
+    }
+    return v;
+}
+
+// Every instruction set gives the same values as the element-wise callable, tail included
+template <detail::simd::arithmetic_op Op, typename T>
+void check_kernels(auto const &op, std::vector<T> const &lhs, std::vector<T> const &rhs) {
+    for (auto const set : {detail::simd::isa::scalar, detail::simd::isa::sse2, detail::simd::isa::avx2}) {
+        std::vector<T> out(lhs.size());
+        detail::simd::transform<Op>(std::span<T const>{lhs}, std::span<T const>{rhs}, std::span<T>{out}, set);
+        for (std::size_t i{}; i < lhs.size(); ++i) {
+            if constexpr (std::floating_point<T>) {
+                REQUIRE(out[i] == Catch::Approx(op(lhs[i], rhs[i])));
+            } else {
+                REQUIRE(out[i] == static_cast<T>(op(lhs[i], rhs[i])));
+            }
+        }
+    }
+}
+}  // namespace
+
+TEST_CASE("zip_with test", "[simd_kernels]") {
+    using detail::simd::arithmetic_op;
+    constexpr std::size_t n = 37;
+    auto const ints = sequence<std::int32_t>(n, -100, 7);
+    auto const int_divisors = sequence<std::int32_t>(n, 3, 5);
+    check_kernels<arithmetic_op::plus>(plus, ints, int_divisors);
+    check_kernels<arithmetic_op::minus>(minus, ints, int_divisors);
+    check_kernels<arithmetic_op::multiplies>(multiplies, ints, int_divisors);
+    check_kernels<arithmetic_op::bit_and>(bit_and, ints, int_divisors);
+    check_kernels<arithmetic_op::bit_or>(bit_or, ints, int_divisors);
+    check_kernels<arithmetic_op::bit_xor>(bit_xor, ints, int_divisors);
+
+    auto const bytes = sequence<std::uint8_t>(n, 250, 3);
+    check_kernels<arithmetic_op::plus>(plus, bytes, bytes);
+    check_kernels<arithmetic_op::multiplies>(multiplies, bytes, bytes);
+
+    // Values exactly representable, so that every instruction set rounds the same way
+    auto const floats = sequence<float>(n, -4.0F, 0.25F);
+    auto const float_divisors = sequence<float>(n, 1.0F, 1.0F);
+    check_kernels<arithmetic_op::plus>(plus, floats, float_divisors);
+    check_kernels<arithmetic_op::multiplies>(multiplies, floats, float_divisors);
+    check_kernels<arithmetic_op::divides>(divides, float_divisors, float_divisors);
+
+    auto const doubles = sequence<double>(n, -4.0, 0.5);
+    check_kernels<arithmetic_op::minus>(minus, doubles, doubles);
+    check_kernels<arithmetic_op::divides>(divides, doubles, sequence<double>(n, 1.0, 1.0));
+}
+
+TEST_CASE("zip_with test", "[materialize_into]") {
+    auto const lhs = sequence<float>(21, 1.0F, 0.5F);
+    auto const rhs = sequence<float>(19, 2.0F, 1.0F);
+
+    auto z = zip_with(_ * _, lhs, rhs);
+    REQUIRE(z.size() == 19);
+    std::array<float, 25> out{};
+    auto const written = z.materialize_into(out);
+    REQUIRE(written.size() == 19);
+    for (std::size_t i{}; i < written.size(); ++i) {
+        REQUIRE(written[i] == Catch::Approx(lhs[i] * rhs[i]));
+    }
+    REQUIRE(out[19] == Catch::Approx(0.0F));
+
+    std::array<float, 4> small{};
+    REQUIRE(z.materialize_into(small).size() == 4);
+    REQUIRE(small[3] == Catch::Approx(lhs[3] * rhs[3]));
+}
+
+TEST_CASE("zip_with test", "[to_vector]") {
+    auto const lhs = sequence<std::int32_t>(50, 0, 3);
+    auto const rhs = sequence<std::int32_t>(50, 10, -1);
+    std::list<std::int32_t> const list(rhs.begin(), rhs.end());
+
+    auto const sections = zip_with(minus, lhs, rhs) | to_vector();
+    auto const transparent = zip_with(std::minus<>{}, lhs, rhs) | to_vector();
+    auto const generic = zip_with([](std::int32_t a, std::int32_t b) { return a - b; }, lhs, rhs) | to_vector();
+    auto const not_contiguous = zip_with(minus, lhs, list) | to_vector();
+    REQUIRE(sections.size() == 50);
+    REQUIRE(sections == generic);
+    REQUIRE(transparent == generic);
+    REQUIRE(not_contiguous == generic);
+
+    // Only the sections of arithmetic operators on contiguous ranges are batched
+    static_assert(decltype(zip_with(minus, lhs, rhs))::batched);
+    static_assert(decltype(zip_with(std::minus<>{}, lhs, rhs))::batched);
+    static_assert(!decltype(zip_with([](std::int32_t a, std::int32_t b) { return a - b; }, lhs, rhs))::batched);
+    static_assert(!decltype(zip_with(minus, lhs, list))::batched);
+}
+
+TEST_CASE("zip_with test", "[to_vector_not_batched]") {
+    struct labelled {
+        explicit labelled(std::string text)
+            : value{std::move(text)} {}
+        std::string value;
+    };
+    std::vector<std::string> const names{"a", "b", "c"};
+    std::vector<int> const ids{1, 2, 3};
+
+    auto const label = [](std::string const &name, int id) { return labelled{name + std::to_string(id)}; };
+    static_assert(!decltype(zip_with(label, names, ids))::batched);
+    auto const labels = zip_with(label, names, ids) | to_vector();
+    REQUIRE(labels.size() == 3);
+    REQUIRE(labels[2].value == "c3");
+}